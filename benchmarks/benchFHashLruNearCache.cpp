@@ -0,0 +1,65 @@
+#include "cacheFixture.h"
+
+// Zipfian 热点负载下对比开启 / 关闭线程本地近端缓存，并报告近端与共享层的命中分布
+class NearCacheFixture : public benchmark::Fixture
+{
+protected:
+    static const int KEY_SPACE = 100000;
+    static const int CAPACITY = 10000;
+    static const size_t KEY_STREAM_SIZE = 1 << 16;
+
+    std::unique_ptr<FreddyCache::FHashLruCache<int, int>> cache_;
+    std::vector<int> keys_;
+
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_ = std::make_unique<FreddyCache::FHashLruCache<int, int>>(CAPACITY, 16, state.range(0));
+        WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+        ScrambledZipfianKeys zipfian(0, KEY_SPACE);
+        keys_.resize(KEY_STREAM_SIZE);
+        for (size_t i = 0; i < KEY_STREAM_SIZE; ++i)
+        {
+            keys_[i] = zipfian.next(gen);
+            cache_->put(keys_[i], keys_[i]);
+        }
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_.reset();
+        keys_.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(NearCacheFixture, ZipfianGet)(benchmark::State & state)
+{
+    size_t i = static_cast<size_t>(state.thread_index()) * (KEY_STREAM_SIZE / 8 + 7);
+    int value;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache_->get(keys_[i++ & (KEY_STREAM_SIZE - 1)], value));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        auto stats = cache_->getNearCacheStats();
+        double total = static_cast<double>(stats.nearHits + stats.sharedHits + stats.misses);
+        if (total > 0)
+        {
+            state.counters["near_hit"] = stats.nearHits / total;
+            state.counters["shared_hit"] = stats.sharedHits / total;
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(NearCacheFixture, ZipfianGet)
+    ->ArgName("nearCapacity")->Arg(0)->Arg(256)->Arg(1024)
+    ->MinWarmUpTime(0.1)->UseRealTime()->ThreadRange(1, 8);
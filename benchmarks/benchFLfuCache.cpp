@@ -0,0 +1,5 @@
+#include "cacheFixture.h"
+
+using Cache = FreddyCache::FLfuCache<int, int>;
+
+FCACHE_BENCHMARK_POLICY(Cache, cacheCapacitiesAndThreads);
@@ -0,0 +1,5 @@
+#include "cacheFixture.h"
+
+using Cache = FreddyCache::FLruCache<int, int>;
+
+FCACHE_BENCHMARK_POLICY(Cache, cacheCapacitiesAndThreads);
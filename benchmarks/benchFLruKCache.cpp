@@ -0,0 +1,6 @@
+#include "cacheFixture.h"
+
+using Cache = FreddyCache::FLruKCache<int, int>;
+
+// FLruKCache 的待定区未加锁，只做单线程测量
+FCACHE_BENCHMARK_POLICY(Cache, cacheCapacities);
@@ -0,0 +1,77 @@
+#include "cacheFixture.h"
+#include "FSmallLruCache.h"
+
+#include <type_traits>
+
+// 小容量下对比编译期定长的 FSmallLruCache 与 FLruCache
+
+template <typename Cache>
+std::unique_ptr<Cache> makeSmallCache(size_t capacity)
+{
+    if constexpr (std::is_default_constructible_v<Cache>)
+        return std::make_unique<Cache>();
+    else
+        return std::make_unique<Cache>(capacity);
+}
+
+// 全部命中
+template <typename Cache, int Capacity>
+void smallCacheHit(benchmark::State & state)
+{
+    auto cache = makeSmallCache<Cache>(Capacity);
+    for (int k = 0; k < Capacity; ++k)
+    {
+        cache->put(k, k);
+    }
+
+    std::vector<int> keys(1 << 12);
+    WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+    UniformKeys hit(0, Capacity);
+    for (auto & key : keys)
+    {
+        key = hit.next(gen);
+    }
+
+    size_t i = 0;
+    int value;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache->get(keys[i++ & (keys.size() - 1)], value));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 读穿透：key 空间为容量的两倍，未命中即写入并淘汰
+template <typename Cache, int Capacity>
+void smallCacheReadThrough(benchmark::State & state)
+{
+    auto cache = makeSmallCache<Cache>(Capacity);
+    std::vector<int> keys(1 << 12);
+    WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+    ZipfianKeys zipfian(0, Capacity * 2);
+    for (auto & key : keys)
+    {
+        key = zipfian.next(gen);
+    }
+
+    size_t i = 0;
+    int value;
+    for (auto _ : state)
+    {
+        int key = keys[i++ & (keys.size() - 1)];
+        if (!cache->get(key, value))
+            cache->put(key, key);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define FCACHE_SMALL_BENCHMARK(Capacity)                                                                    \
+    BENCHMARK_TEMPLATE(smallCacheHit, FreddyCache::FSmallLruCache<int, int, Capacity>, Capacity);          \
+    BENCHMARK_TEMPLATE(smallCacheHit, FreddyCache::FLruCache<int, int>, Capacity);                         \
+    BENCHMARK_TEMPLATE(smallCacheReadThrough, FreddyCache::FSmallLruCache<int, int, Capacity>, Capacity);  \
+    BENCHMARK_TEMPLATE(smallCacheReadThrough, FreddyCache::FLruCache<int, int>, Capacity)
+
+FCACHE_SMALL_BENCHMARK(8);
+FCACHE_SMALL_BENCHMARK(16);
+FCACHE_SMALL_BENCHMARK(32);
+FCACHE_SMALL_BENCHMARK(64);
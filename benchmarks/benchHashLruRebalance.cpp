@@ -0,0 +1,71 @@
+#include "cacheFixture.h"
+
+// 热点 key 集中在少数分片时，对比单一全局 LRU、固定分片容量与自适应分片容量的命中率
+class ClusteredKeysFixture : public benchmark::Fixture
+{
+protected:
+    static const int KEY_SPACE = 40000;
+    static const int CAPACITY = 4096;
+    static const int SLICES = 16;
+    static const size_t KEY_STREAM_SIZE = 1 << 20;
+
+    std::unique_ptr<FreddyCache::FCachePolicy<int, int>> cache_;
+    std::vector<int> keys_;
+
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        // mode: 0 全局 LRU，1 固定分片，2 自适应分片
+        if (state.range(0) == 0)
+            cache_ = std::make_unique<FreddyCache::FLruCache<int, int>>(CAPACITY);
+        else
+            cache_ = std::make_unique<FreddyCache::FHashLruCache<int, int>>(CAPACITY, SLICES, 0, state.range(0) == 2);
+
+        // Zipfian 热度，key 经映射后只落在 16 个分片中的 4 个
+        WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+        ZipfianKeys zipfian(0, KEY_SPACE, 0.9);
+        keys_.resize(KEY_STREAM_SIZE);
+        for (size_t i = 0; i < KEY_STREAM_SIZE; ++i)
+        {
+            uint32_t rank = zipfian.next(gen);
+            keys_[i] = rank * SLICES / 4 + rank % 4;
+        }
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_.reset();
+        keys_.clear();
+    }
+};
+
+// 读穿透：未命中即写入
+BENCHMARK_DEFINE_F(ClusteredKeysFixture, ReadThrough)(benchmark::State & state)
+{
+    size_t i = static_cast<size_t>(state.thread_index()) * (KEY_STREAM_SIZE / 8 + 7);
+    size_t gets = 0, hits = 0;
+    int value;
+    for (auto _ : state)
+    {
+        int key = keys_[i++ & (KEY_STREAM_SIZE - 1)];
+        gets++;
+        if (cache_->get(key, value))
+            hits++;
+        else
+            cache_->put(key, key);
+    }
+    state.SetItemsProcessed(state.iterations());
+    // 各线程各自上报，由框架在线程结束后取平均，不必在停止屏障之后读共享计数
+    state.counters["hit_rate"] = benchmark::Counter(
+        static_cast<double>(hits) / std::max<size_t>(1, gets), benchmark::Counter::kAvgThreads);
+}
+
+BENCHMARK_REGISTER_F(ClusteredKeysFixture, ReadThrough)
+    ->ArgName("mode")->Arg(0)->Arg(1)->Arg(2)
+    ->MinWarmUpTime(0.1)->UseRealTime()->ThreadRange(1, 8);
@@ -0,0 +1,75 @@
+#include "cacheFixture.h"
+
+#include <atomic>
+#include <string>
+
+// 持续淘汰的写入负载下，对比无监听器、锁外内联投递与后台线程投递的写入开销
+class EvictionListenerFixture : public benchmark::Fixture
+{
+protected:
+    static const int CAPACITY = 1024;
+    static const size_t KEY_STREAM_SIZE = 1 << 16;
+
+    using Notifier = FreddyCache::FRemovalNotifier<int, std::string>;
+
+    std::unique_ptr<FreddyCache::FHashLruCache<int, std::string>> cache_;
+    std::shared_ptr<Notifier> notifier_;
+    std::atomic<size_t> delivered_;
+    std::vector<int> keys_;
+
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_ = std::make_unique<FreddyCache::FHashLruCache<int, std::string>>(CAPACITY, 16);
+        delivered_.store(0, std::memory_order_relaxed);
+        if (state.range(0) > 0)
+        {
+            auto mode = state.range(0) == 1 ? FreddyCache::FDeliveryMode::Inline : FreddyCache::FDeliveryMode::Background;
+            notifier_ = std::make_shared<Notifier>([this](const std::vector<Notifier::Event> & batch) {
+                delivered_.fetch_add(batch.size(), std::memory_order_relaxed);
+            }, 4096, mode);
+            cache_->setRemovalNotifier(notifier_);
+        }
+
+        // key 空间远大于容量，几乎每次写入都触发一次淘汰
+        WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+        UniformKeys keys(0, CAPACITY * 64);
+        keys_.resize(KEY_STREAM_SIZE);
+        for (size_t i = 0; i < KEY_STREAM_SIZE; ++i)
+        {
+            keys_[i] = keys.next(gen);
+        }
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_.reset();
+        notifier_.reset();
+        keys_.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(EvictionListenerFixture, EvictingPut)(benchmark::State & state)
+{
+    size_t i = static_cast<size_t>(state.thread_index()) * (KEY_STREAM_SIZE / 8 + 7);
+    const std::string value(64, 'v');
+    for (auto _ : state)
+    {
+        cache_->put(keys_[i++ & (KEY_STREAM_SIZE - 1)], value);
+    }
+    if (state.thread_index() == 0 && notifier_)
+    {
+        notifier_->flush();
+        state.counters["delivered"] = benchmark::Counter(delivered_.load(), benchmark::Counter::kIsRate);
+    }
+}
+
+// mode: 0 无监听器，1 内联投递，2 后台投递
+BENCHMARK_REGISTER_F(EvictionListenerFixture, EvictingPut)
+    ->ArgName("mode")->Arg(0)->Arg(1)->Arg(2)->UseRealTime()->ThreadRange(1, 8);
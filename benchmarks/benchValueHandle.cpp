@@ -0,0 +1,72 @@
+#include "cacheFixture.h"
+
+#include <string>
+
+// 大 value 下对比拷贝读取 get(key, value) 与句柄读取 getHandle(key)
+class LargeValueFixture : public benchmark::Fixture
+{
+protected:
+    static const int CAPACITY = 1024;
+    static const size_t KEY_STREAM_SIZE = 1 << 16;
+
+    std::unique_ptr<FreddyCache::FLruCache<int, std::string>> cache_;
+    std::vector<int> keys_;
+
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_ = std::make_unique<FreddyCache::FLruCache<int, std::string>>(CAPACITY);
+        for (int k = 0; k < CAPACITY; ++k)
+        {
+            cache_->put(k, std::string(state.range(0), 'v'));
+        }
+
+        WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+        UniformKeys keys(0, CAPACITY);
+        keys_.resize(KEY_STREAM_SIZE);
+        for (size_t i = 0; i < KEY_STREAM_SIZE; ++i)
+        {
+            keys_[i] = keys.next(gen);
+        }
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_.reset();
+        keys_.clear();
+    }
+};
+
+BENCHMARK_DEFINE_F(LargeValueFixture, CopyGet)(benchmark::State & state)
+{
+    size_t i = static_cast<size_t>(state.thread_index()) * (KEY_STREAM_SIZE / 8 + 7);
+    std::string value;
+    for (auto _ : state)
+    {
+        cache_->get(keys_[i++ & (KEY_STREAM_SIZE - 1)], value);
+        benchmark::DoNotOptimize(value.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_DEFINE_F(LargeValueFixture, HandleGet)(benchmark::State & state)
+{
+    size_t i = static_cast<size_t>(state.thread_index()) * (KEY_STREAM_SIZE / 8 + 7);
+    for (auto _ : state)
+    {
+        auto handle = cache_->getHandle(keys_[i++ & (KEY_STREAM_SIZE - 1)]);
+        benchmark::DoNotOptimize(handle->data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(LargeValueFixture, CopyGet)
+    ->ArgName("valueBytes")->Arg(64)->Arg(4096)->Arg(65536)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_REGISTER_F(LargeValueFixture, HandleGet)
+    ->ArgName("valueBytes")->Arg(64)->Arg(4096)->Arg(65536)->UseRealTime()->ThreadRange(1, 8);
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "FLruCache.h"
+#include "FLfuCache.h"
+#include "FGdsfCache.h"
+#include "workload.h"
+
+// 各策略的构造参数，与 tests/cachesTestBox.cpp 中的场景保持一致
+template <typename Cache>
+struct CacheFactory;
+
+template <typename Key, typename Value>
+struct CacheFactory<FreddyCache::FLruCache<Key, Value>>
+{
+    static std::unique_ptr<FreddyCache::FLruCache<Key, Value>> create(size_t capacity)
+    {
+        return std::make_unique<FreddyCache::FLruCache<Key, Value>>(capacity);
+    }
+};
+
+template <typename Key, typename Value>
+struct CacheFactory<FreddyCache::FLruKCache<Key, Value>>
+{
+    static std::unique_ptr<FreddyCache::FLruKCache<Key, Value>> create(size_t capacity)
+    {
+        return std::make_unique<FreddyCache::FLruKCache<Key, Value>>(capacity, capacity, K);
+    }
+
+    static constexpr int K = 2;
+};
+
+template <typename Key, typename Value>
+struct CacheFactory<FreddyCache::FLfuCache<Key, Value>>
+{
+    static std::unique_ptr<FreddyCache::FLfuCache<Key, Value>> create(size_t capacity)
+    {
+        return std::make_unique<FreddyCache::FLfuCache<Key, Value>>(capacity, 100, 10);
+    }
+};
+
+template <typename Key, typename Value>
+struct CacheFactory<FreddyCache::FHashLruCache<Key, Value>>
+{
+    static std::unique_ptr<FreddyCache::FHashLruCache<Key, Value>> create(size_t capacity)
+    {
+        return std::make_unique<FreddyCache::FHashLruCache<Key, Value>>(capacity, 16);
+    }
+};
+
+template <typename Key, typename Value>
+struct CacheFactory<FreddyCache::FSlruCache<Key, Value>>
+{
+    static std::unique_ptr<FreddyCache::FSlruCache<Key, Value>> create(size_t capacity)
+    {
+        return std::make_unique<FreddyCache::FSlruCache<Key, Value>>(capacity);
+    }
+};
+
+template <typename Key, typename Value>
+struct CacheFactory<FreddyCache::FGdsfCache<Key, Value>>
+{
+    static std::unique_ptr<FreddyCache::FGdsfCache<Key, Value>> create(size_t capacity)
+    {
+        return std::make_unique<FreddyCache::FGdsfCache<Key, Value>>(capacity);
+    }
+};
+
+// 新 key 进入主缓存所需的 put 次数：LRU-K 的新 key 先落入待定区，第 K 次 put 才进入主缓存
+template <typename Cache>
+struct CacheAdmission
+{
+    static constexpr int PUTS = 1;
+};
+
+template <typename Key, typename Value>
+struct CacheAdmission<FreddyCache::FLruKCache<Key, Value>>
+{
+    static constexpr int PUTS = CacheFactory<FreddyCache::FLruKCache<Key, Value>>::K;
+};
+
+// 容量 16 ~ 10M
+inline void cacheCapacities(benchmark::internal::Benchmark * b)
+{
+    for (int64_t capacity : { 16, 256, 4096, 65536, 1 << 20, 10000000 })
+    {
+        b->Arg(capacity);
+    }
+    b->ArgName("capacity")->MinWarmUpTime(0.1)->UseRealTime();
+}
+
+// 容量 × 线程数，仅适用于线程安全的策略
+inline void cacheCapacitiesAndThreads(benchmark::internal::Benchmark * b)
+{
+    cacheCapacities(b);
+    b->ThreadRange(1, 8);
+}
+
+// 夹具：线程 0 负责建缓存并填满 [0, capacity)，各线程在预生成的 key 流上错位读取
+template <typename Cache>
+class CacheFixture : public benchmark::Fixture
+{
+protected:
+    static const size_t KEY_STREAM_SIZE = 1 << 16;
+    static const size_t INSERTS_PER_REFILL = 1 << 16; // 插入路径每批空缓存至少覆盖的插入次数
+
+    std::unique_ptr<Cache> cache_;
+    std::vector<int> hitKeys_;
+    std::vector<int> missKeys_;
+    int capacity_;
+
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        capacity_ = static_cast<int>(state.range(0));
+        cache_ = CacheFactory<Cache>::create(capacity_);
+        for (int k = 0; k < capacity_; ++k)
+        {
+            admit(*cache_, k);
+        }
+
+        WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+        UniformKeys hit(0, capacity_);
+        UniformKeys miss(capacity_, capacity_);
+        hitKeys_.resize(KEY_STREAM_SIZE);
+        missKeys_.resize(KEY_STREAM_SIZE);
+        for (size_t i = 0; i < KEY_STREAM_SIZE; ++i)
+        {
+            hitKeys_[i] = hit.next(gen);
+            missKeys_[i] = miss.next(gen);
+        }
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        if (state.thread_index() != 0)
+            return;
+
+        cache_.reset();
+        hitKeys_.clear();
+        missKeys_.clear();
+    }
+
+protected:
+    // 命中路径：key 均在缓存中
+    void runHit(benchmark::State & state)
+    {
+        size_t i = streamOffset(state);
+        int value;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(cache_->get(hitKeys_[i++ & (KEY_STREAM_SIZE - 1)], value));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // 未命中路径：key 均不在缓存中
+    void runMiss(benchmark::State & state)
+    {
+        size_t i = streamOffset(state);
+        int value;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(cache_->get(missKeys_[i++ & (KEY_STREAM_SIZE - 1)], value));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // 更新路径：put 已存在的 key
+    void runUpdate(benchmark::State & state)
+    {
+        size_t i = streamOffset(state);
+        for (auto _ : state)
+        {
+            int key = hitKeys_[i++ & (KEY_STREAM_SIZE - 1)];
+            cache_->put(key, key + 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // 插入路径：从空缓存开始 put 新 key。预先建好一批空缓存轮流填满，整批用完才暂停计时重建，
+    // 暂停本身的开销均摊到至少 INSERTS_PER_REFILL 次插入上，小容量与大容量的结果可比；缓存需要重建，只测单线程
+    void runInsert(benchmark::State & state)
+    {
+        cache_.reset();
+        const size_t poolSize = std::max<size_t>(1, INSERTS_PER_REFILL / capacity_);
+        std::vector<std::unique_ptr<Cache>> pool;
+        refill(pool, poolSize);
+        size_t current = 0;
+        int key = 0;
+        for (auto _ : state)
+        {
+            if (key == capacity_)
+            {
+                key = 0;
+                if (++current == pool.size())
+                {
+                    state.PauseTiming();
+                    refill(pool, poolSize);
+                    current = 0;
+                    state.ResumeTiming();
+                }
+            }
+            admit(*pool[current], key++);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // 淘汰路径：新 key 进入已满的主缓存，每次插入都触发淘汰（LRU-K 含待定区到主缓存的晋升）
+    void runEvict(benchmark::State & state)
+    {
+        int key = capacity_ + state.thread_index();
+        for (auto _ : state)
+        {
+            admit(*cache_, key);
+            key += state.threads();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+private:
+    static void admit(Cache & cache, int key)
+    {
+        for (int i = 0; i < CacheAdmission<Cache>::PUTS; ++i)
+        {
+            cache.put(key, key);
+        }
+    }
+
+    void refill(std::vector<std::unique_ptr<Cache>> & pool, size_t poolSize) const
+    {
+        pool.clear();
+        for (size_t i = 0; i < poolSize; ++i)
+        {
+            pool.push_back(CacheFactory<Cache>::create(capacity_));
+        }
+    }
+
+    size_t streamOffset(const benchmark::State & state) const
+    {
+        return static_cast<size_t>(state.thread_index()) * (KEY_STREAM_SIZE / 8 + 7);
+    }
+};
+
+// 为一种策略定义并注册 hit/miss/insert/update/evict 五个基准，insert 只跑单线程
+#define FCACHE_BENCHMARK_POLICY(Cache, Configure)                                         \
+    BENCHMARK_TEMPLATE_DEFINE_F(CacheFixture, Hit, Cache)(benchmark::State & state)     \
+    { runHit(state); }                                                                  \
+    BENCHMARK_TEMPLATE_DEFINE_F(CacheFixture, Miss, Cache)(benchmark::State & state)    \
+    { runMiss(state); }                                                                 \
+    BENCHMARK_TEMPLATE_DEFINE_F(CacheFixture, Insert, Cache)(benchmark::State & state)  \
+    { runInsert(state); }                                                               \
+    BENCHMARK_TEMPLATE_DEFINE_F(CacheFixture, Update, Cache)(benchmark::State & state)  \
+    { runUpdate(state); }                                                               \
+    BENCHMARK_TEMPLATE_DEFINE_F(CacheFixture, Evict, Cache)(benchmark::State & state)   \
+    { runEvict(state); }                                                                \
+    BENCHMARK_REGISTER_F(CacheFixture, Hit)->Apply(Configure);                            \
+    BENCHMARK_REGISTER_F(CacheFixture, Miss)->Apply(Configure);                           \
+    BENCHMARK_REGISTER_F(CacheFixture, Insert)->Apply(cacheCapacities);                   \
+    BENCHMARK_REGISTER_F(CacheFixture, Update)->Apply(Configure);                         \
+    BENCHMARK_REGISTER_F(CacheFixture, Evict)->Apply(Configure)
@@ -1,20 +1,67 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
 namespace FreddyCache
 {
 
+// 缓存索引使用的哈希：std::string 键额外支持以 std::string_view / const char* 异构查找
+template <typename Key>
+struct FHash : std::hash<Key>
+{};
+
+template <>
+struct FHash<std::string>
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+// K 可以不构造 Key 而直接用于查找
+template <typename Key, typename K>
+concept FHeterogeneousKey = requires { typename FHash<Key>::is_transparent; }
+    && !std::is_same_v<std::remove_cvref_t<K>, Key>;
+
+template <typename Key, typename Value>
+using FIndexMap = std::unordered_map<Key, Value, FHash<Key>, std::equal_to<>>;
+
 template <typename Key, typename Value>
 class FCachePolicy
 {
 public:
     virtual ~FCachePolicy() {};
 
-    // 添加缓存接口
-    virtual void put(Key key, Value value) = 0;
+    // 添加缓存接口：右值版本把 value 移入缓存，全程只移动一次
+    virtual void put(const Key & key, const Value & value) = 0;
+    virtual void put(const Key & key, Value && value) = 0;
+    virtual void put(Key && key, Value && value) = 0;
+
+    // 携带未命中代价与数据大小的添加接口，不区分代价的策略忽略这两个参数
+    virtual void putWithCost(const Key & key, const Value & value, double /*cost*/, size_t /*size*/)
+    {
+        put(key, value);
+    }
 
     // 两种获取缓存接口
-    virtual bool get(Key key, Value & value) = 0;
-    virtual Value get(Key key) = 0;
+    virtual bool get(const Key & key, Value & value) = 0;
+    virtual Value get(const Key & key) = 0;
+
+    // 累计因容量不足被淘汰的条目数，观测方按窗口求差得到淘汰率；不统计的策略返回 0
+    virtual size_t getEvictionCount() const
+    {
+        return 0;
+    }
 };
 
 template <typename Key, typename Value>
@@ -23,17 +70,86 @@ class Node
 protected:
     Key     key_;
     Value   value_;
+    std::atomic<size_t> pins_{0}; // 存活的 FValueHandle 数量，非零时缓存不得原地改写 value_
 public:
-    Node(Key key, Value value)
-        : key_(key)
-        , value_(value)
+    template <typename K, typename V>
+    Node(K && key, V && value)
+        : key_(std::forward<K>(key))
+        , value_(std::forward<V>(value))
+    {}
+
+    // 就地构造 value
+    template <typename K, typename... Args>
+    Node(std::in_place_t, K && key, Args &&... args)
+        : key_(std::forward<K>(key))
+        , value_(std::forward<Args>(args)...)
     {}
 
     // 提供必要的访问器
-    Key     getKey() const { return key_; }
-    Value   getValue() const { return value_; }
-    void    setValue(const Value& value) { value_ = value; }
+    const Key & getKey() const { return key_; }
+    template <typename K>
+    void    setKey(K && key) { key_ = std::forward<K>(key); }
+    const Value & getValue() const { return value_; }
+    template <typename V>
+    void    setValue(V && value) { value_ = std::forward<V>(value); }
+    // 节点的值即将离开缓存时取出：未被句柄钉住时直接移出，否则拷贝；须在缓存锁内调用
+    Value   takeValue()
+    {
+        if (isPinned())
+            return value_;
+        return std::move(value_);
+    }
+
+    void    pin() { pins_.fetch_add(1, std::memory_order_relaxed); }
+    void    unpin() { pins_.fetch_sub(1, std::memory_order_release); }
+    bool    isPinned() const { return pins_.load(std::memory_order_acquire) > 0; }
+
+};
+
+// 只读值句柄：持有节点引用并钉住节点，读取时无需拷贝也无需持锁；
+// 节点被淘汰或被新值替换后，旧节点在最后一个句柄释放时才回收
+template <typename Value, typename NodeType>
+class FValueHandle
+{
+private:
+    std::shared_ptr<NodeType> node_;
+public:
+    FValueHandle() = default;
+
+    explicit FValueHandle(std::shared_ptr<NodeType> node)
+        : node_(std::move(node))
+    {
+        if (node_)
+            node_->pin();
+    }
+
+    FValueHandle(const FValueHandle & other)
+        : node_(other.node_)
+    {
+        if (node_)
+            node_->pin();
+    }
+
+    FValueHandle(FValueHandle && other) noexcept
+        : node_(std::move(other.node_))
+    {}
+
+    FValueHandle & operator=(FValueHandle other) noexcept
+    {
+        std::swap(node_, other.node_);
+        return *this;
+    }
+
+    ~FValueHandle()
+    {
+        if (node_)
+            node_->unpin();
+    }
+
+    explicit operator bool() const { return node_ != nullptr; }
 
+    const Value & operator*() const { return node_->getValue(); }
+    const Value * operator->() const { return &node_->getValue(); }
 };
 
 } // namespace FreddyCache
\ No newline at end of file
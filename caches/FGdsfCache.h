@@ -0,0 +1,254 @@
+#pragma once
+
+#include "FCachePolicy.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace FreddyCache
+{
+
+// GDSF（GreedyDual-Size-Frequency）：优先级 H = L + 频次 * 未命中代价 / 大小，淘汰 H 最小者，
+// L 为膨胀时钟，每次淘汰后置为被淘汰者的 H，使长期不被访问的旧数据逐渐让位
+template <typename Key, typename Value>
+class FGdsfCache : public FCachePolicy<Key, Value>
+{
+private:
+    struct Entry
+    {
+        Key      key;
+        Value    value;
+        double   cost;
+        size_t   size;
+        size_t   frequency;
+        double   priority;
+        uint64_t sequence;  // 最近访问序号，优先级相同时先淘汰较旧者
+        size_t   heapIndex;
+    };
+    using EntryPtr = std::unique_ptr<Entry>;
+    using EntryMap = FIndexMap<Key, EntryPtr>;
+
+    size_t   capacity_;     // 以 size 计的总容量，size 恒为 1 时即条目数
+    size_t   usedSize_;
+    double   inflation_;
+    uint64_t sequence_;
+    EntryMap entryMap_;
+    std::vector<Entry *> heap_; // 按 (priority, sequence) 排列的索引最小堆
+    std::mutex mutex_;
+    std::atomic<size_t> evictionCount_{0};
+
+public:
+    FGdsfCache(size_t capacity)
+        : capacity_(capacity)
+        , usedSize_(0)
+        , inflation_(0)
+        , sequence_(0)
+    {}
+
+    ~FGdsfCache() override = default;
+
+    size_t getEvictionCount() const override
+    {
+        return evictionCount_.load(std::memory_order_relaxed);
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value, 1.0, 1);
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        putImpl(key, std::move(value), 1.0, 1);
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        putImpl(std::move(key), std::move(value), 1.0, 1);
+    }
+
+    void putWithCost(const Key & key, const Value & value, double cost, size_t size) override
+    {
+        putImpl(key, value, cost, size);
+    }
+
+    void putWithCost(const Key & key, Value && value, double cost, size_t size)
+    {
+        putImpl(key, std::move(value), cost, size);
+    }
+
+    bool get(const Key & key, Value & value) override
+    {
+        return getImpl(key, value);
+    }
+
+    template <typename K> requires FHeterogeneousKey<Key, K>
+    bool get(const K & key, Value & value)
+    {
+        return getImpl(key, value);
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
+    }
+
+    template <typename K>
+    void remove(const K & key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entryMap_.find(key);
+        if (it != entryMap_.end())
+        {
+            detach(it->second.get());
+            entryMap_.erase(it);
+        }
+    }
+
+private:
+    template <typename K, typename V>
+    void putImpl(K && key, V && value, double cost, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entryMap_.find(key);
+        if (size == 0 || size > capacity_)
+        {
+            // 新值放不进缓存，旧值已过期，不能继续对外提供
+            if (it != entryMap_.end())
+            {
+                detach(it->second.get());
+                entryMap_.erase(it);
+            }
+            return;
+        }
+
+        if (it != entryMap_.end())
+        {
+            Entry * entry = it->second.get();
+            entry->value = std::forward<V>(value);
+            usedSize_ = usedSize_ - entry->size + size;
+            entry->cost = cost;
+            entry->size = size;
+            touch(entry);
+            while (usedSize_ > capacity_)
+                evictLowestPriority();
+            return;
+        }
+
+        while (usedSize_ + size > capacity_)
+            evictLowestPriority();
+
+        auto entry = std::make_unique<Entry>(Entry{std::forward<K>(key), std::forward<V>(value), cost, size, 1, 0, 0, heap_.size()});
+        entry->priority = priorityOf(*entry);
+        entry->sequence = ++sequence_;
+        heap_.push_back(entry.get());
+        siftUp(entry->heapIndex);
+        usedSize_ += size;
+        const Key & indexKey = entry->key;
+        entryMap_.emplace(indexKey, std::move(entry));
+    }
+
+    template <typename K>
+    bool getImpl(const K & key, Value & value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entryMap_.find(key);
+        if (it == entryMap_.end())
+            return false;
+
+        touch(it->second.get());
+        value = it->second->value;
+        return true;
+    }
+
+    double priorityOf(const Entry & entry) const
+    {
+        return inflation_ + entry.frequency * entry.cost / entry.size;
+    }
+
+    // 命中或更新：频次加一并按当前膨胀时钟重算优先级；更新可能改变代价与大小，两个方向都要调整
+    void touch(Entry * entry)
+    {
+        entry->frequency++;
+        entry->priority = priorityOf(*entry);
+        entry->sequence = ++sequence_;
+        siftUp(entry->heapIndex);
+        siftDown(entry->heapIndex);
+    }
+
+    void evictLowestPriority()
+    {
+        Entry * victim = heap_.front();
+        inflation_ = victim->priority;
+        detach(victim);
+        entryMap_.erase(entryMap_.find(victim->key));
+        evictionCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 从堆中摘除并归还容量，不释放条目
+    void detach(Entry * entry)
+    {
+        size_t index = entry->heapIndex;
+        usedSize_ -= entry->size;
+        swapEntries(index, heap_.size() - 1);
+        heap_.pop_back();
+        if (index < heap_.size())
+        {
+            Entry * moved = heap_[index];
+            siftUp(index);
+            siftDown(moved->heapIndex);
+        }
+    }
+
+    bool lessThan(size_t a, size_t b) const
+    {
+        if (heap_[a]->priority != heap_[b]->priority)
+            return heap_[a]->priority < heap_[b]->priority;
+        return heap_[a]->sequence < heap_[b]->sequence;
+    }
+
+    void swapEntries(size_t a, size_t b)
+    {
+        std::swap(heap_[a], heap_[b]);
+        heap_[a]->heapIndex = a;
+        heap_[b]->heapIndex = b;
+    }
+
+    void siftUp(size_t index)
+    {
+        while (index > 0)
+        {
+            size_t parent = (index - 1) / 2;
+            if (!lessThan(index, parent))
+                break;
+            swapEntries(index, parent);
+            index = parent;
+        }
+    }
+
+    void siftDown(size_t index)
+    {
+        size_t count = heap_.size();
+        while (true)
+        {
+            size_t smallest = index;
+            size_t left = 2 * index + 1;
+            size_t right = left + 1;
+            if (left < count && lessThan(left, smallest))
+                smallest = left;
+            if (right < count && lessThan(right, smallest))
+                smallest = right;
+            if (smallest == index)
+                break;
+            swapEntries(index, smallest);
+            index = smallest;
+        }
+    }
+};
+
+} // namespace FreddyCache
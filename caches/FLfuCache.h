@@ -1,7 +1,9 @@
 #pragma once
 
 #include "FCachePolicy.h"
+#include "FRemovalListener.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <map>
@@ -21,8 +23,9 @@ public:
     std::shared_ptr<LfuNode<Key, Value>> next_;
 
 public:
-    LfuNode(Key key, Value value)
-        : Node<Key, Value>(key, value)
+    template <typename... Args>
+    LfuNode(Args &&... args)
+        : Node<Key, Value>(std::forward<Args>(args)...)
         , accessCount_(1)
     {}
 
@@ -112,15 +115,19 @@ private:
     using NodePtr = std::shared_ptr<Node>;
     using NodeList = LfuNodeList<Key, Value>;
     using NodeListPtr = std::shared_ptr<NodeList>;
-    using NodeMap = std::unordered_map<Key, NodePtr>;
+    using NodeMap = FIndexMap<Key, NodePtr>;
     using NodeListMap = std::map<size_t, NodeListPtr>;
-
+public:
+    using ValueHandle = FValueHandle<Value, Node>;
+private:
     size_t capacity_;
     size_t revolvingThreshold_;
     size_t granularity_;
     NodeMap nodeMap_;
     NodeListMap nodeListMap_;
     std::mutex mutex_;
+    std::shared_ptr<FRemovalNotifier<Key, Value>> notifier_; // 为空时不产生移除事件
+    std::atomic<size_t> evictionCount_{0};
 
 public:
     FLfuCache(size_t capacity, size_t revolvingThreshold, size_t granularity)
@@ -131,14 +138,43 @@ public:
 
     ~FLfuCache() override = default;
 
-    void put(Key key, Value value) override
+    size_t getEvictionCount() const override
+    {
+        return evictionCount_.load(std::memory_order_relaxed);
+    }
+
+    // 注册移除通知器，应在开始读写缓存之前设置
+    void setRemovalNotifier(std::shared_ptr<FRemovalNotifier<Key, Value>> notifier)
+    {
+        notifier_ = std::move(notifier);
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value);
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        putImpl(key, std::move(value));
+    }
+
+    void put(Key && key, Value && value) override
     {
+        putImpl(std::move(key), std::move(value));
+    }
+
+    // 就地构造 value，已存在时以新构造的值替换
+    template <typename... Args>
+    void emplace(const Key & key, Args &&... args)
+    {
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
         std::lock_guard<std::mutex> lock(mutex_);
         revolveIfNeeded();
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end())
         {
-            it->second->setValue(value);
+            updateExistingNode(it->second, Value(std::forward<Args>(args)...));
             incrementAccessCount(it->second);
             return;
         }
@@ -147,10 +183,88 @@ public:
         {
             evictLeastFrequent();
         }
-        addNewNode(key, value);
+        addNewNode(std::make_shared<Node>(std::in_place, key, std::forward<Args>(args)...));
     }
 
-    bool get(Key key, Value & value) override
+    bool get(const Key & key, Value & value) override
+    {
+        return getImpl(key, value);
+    }
+
+    template <typename K> requires FHeterogeneousKey<Key, K>
+    bool get(const K & key, Value & value)
+    {
+        return getImpl(key, value);
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
+    }
+
+    // 零拷贝读取：锁内只做索引与频次调整，未命中时返回空句柄
+    template <typename K>
+    ValueHandle getHandle(const K & key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        revolveIfNeeded();
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            incrementAccessCount(it->second);
+            return ValueHandle(it->second);
+        }
+        return ValueHandle();
+    }
+
+    template <typename K>
+    void remove(const K & key)
+    {
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end())
+            return;
+
+        NodePtr node = it->second;
+        if (notifier_)
+            notifier_->enqueue(node->getKey(), node->takeValue(), FRemovalCause::Explicit);
+
+        auto listIt = nodeListMap_.find(node->getAccessCount() / granularity_);
+        listIt->second->remove(node);
+        if (listIt->second->isEmpty())
+        {
+            nodeListMap_.erase(listIt);
+        }
+        nodeMap_.erase(it);
+    }
+
+private:
+    template <typename K, typename V>
+    void putImpl(K && key, V && value)
+    {
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
+        std::lock_guard<std::mutex> lock(mutex_);
+        revolveIfNeeded();
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            updateExistingNode(it->second, std::forward<V>(value));
+            incrementAccessCount(it->second);
+            return;
+        }
+
+        if (nodeMap_.size() == capacity_)
+        {
+            evictLeastFrequent();
+        }
+        addNewNode(std::make_shared<Node>(std::forward<K>(key), std::forward<V>(value)));
+    }
+
+    template <typename K>
+    bool getImpl(const K & key, Value & value)
     {
         std::lock_guard<std::mutex> lock(mutex_);
         revolveIfNeeded();
@@ -165,14 +279,27 @@ public:
         return false;
     }
 
-    Value get(Key key) override
+    // 节点被句柄钉住时换上同频次的新节点，旧节点随最后一个句柄释放
+    template <typename V>
+    void updateExistingNode(NodePtr & node, V && value)
     {
-        Value value{};
-        get(key, value);
-        return value;
+        if (notifier_)
+            notifier_->enqueue(node->getKey(), node->takeValue(), FRemovalCause::Replaced);
+
+        if (!node->isPinned())
+        {
+            node->setValue(std::forward<V>(value));
+            return;
+        }
+
+        NodeListPtr nodeList = nodeListMap_[node->getAccessCount() / granularity_];
+        NodePtr newNode = std::make_shared<Node>(node->getKey(), std::forward<V>(value));
+        newNode->setAccessCount(node->getAccessCount());
+        nodeList->remove(node);
+        nodeList->insert(newNode);
+        node = newNode;
     }
 
-private:
     void incrementAccessCount(NodePtr node)
     {
         size_t accessCount = node->getAccessCount();
@@ -206,17 +333,20 @@ private:
     {
         NodeListPtr nodeList = nodeListMap_.begin()->second;
         NodePtr node = nodeList->getLeastRecent();
+        if (notifier_)
+            notifier_->enqueue(node->getKey(), node->takeValue(), FRemovalCause::Size);
         nodeList->remove(node);
         nodeMap_.erase(node->getKey());
+        evictionCount_.fetch_add(1, std::memory_order_relaxed);
         if (nodeList->isEmpty())
         {
             nodeListMap_.erase(nodeListMap_.begin());
         }
     }
 
-    void addNewNode(const Key & key, const Value & value)
+    // 节点已持有 key 与 value，索引从节点复制 key
+    void addNewNode(NodePtr node)
     {
-        NodePtr node = std::make_shared<Node>(key, value);
         size_t accessCount = node->getAccessCount();
         size_t level = accessCount / granularity_;
         if (nodeListMap_.find(level) == nodeListMap_.end())
@@ -224,7 +354,7 @@ private:
             nodeListMap_.emplace(level, std::make_shared<NodeList>());
         }
         nodeListMap_[level]->insert(node);
-        nodeMap_[key] = node;
+        nodeMap_.emplace(node->getKey(), node);
     }
 
     void revolveIfNeeded()
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "FCachePolicy.h"
+#include "FRemovalListener.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <mutex>
@@ -21,8 +24,9 @@ public:
     std::weak_ptr<LruNode<Key, Value>> prev_;
     std::shared_ptr<LruNode<Key, Value>> next_;
 public:
-    LruNode(Key key, Value value)
-        : Node<Key, Value>(key, value)
+    template <typename... Args>
+    LruNode(Args &&... args)
+        : Node<Key, Value>(std::forward<Args>(args)...)
     {}
 
     friend class FLruCache<Key, Value>;
@@ -33,70 +37,226 @@ class FLruCache : public FCachePolicy<Key, Value>
 {
     using LruNodeType = LruNode<Key, Value>;
     using NodePtr = std::shared_ptr<LruNodeType>;
-    using NodeMap = std::unordered_map<Key, NodePtr>;
+    using NodeMap = FIndexMap<Key, NodePtr>;
+public:
+    using ValueHandle = FValueHandle<Value, LruNodeType>;
 private:
-    int     capacity_;
+    std::atomic<int> capacity_; // 可被 setCapacity 调整，锁外只做是否为 0 的判断
     NodeMap nodeMap_;
     std::mutex mutex_;
     NodePtr dummyHead_;
     NodePtr dummyTail_;
+    std::shared_ptr<FRemovalNotifier<Key, Value>> notifier_; // 为空时不产生移除事件
+    std::atomic<size_t> evictionCount_{0};
+
+    // 幽灵表：只记录最近被淘汰 key 的哈希指纹（直接映射、有损），
+    // 未命中时若指纹仍在则说明多一点容量就能命中，为空时不启用
+    std::vector<size_t> ghost_;
+    int     ghostShift_;
+    std::atomic<size_t> ghostHitCount_{0};
 public:
+    using RemovalNotifier = FRemovalNotifier<Key, Value>;
+
     FLruCache(int capacity)
         : capacity_(capacity)
+        , ghostShift_(0)
     {
         initializeList();
     }
 
     ~FLruCache() override = default;
 
-    void put(Key key, Value value) override
+    size_t getEvictionCount() const override
+    {
+        return evictionCount_.load(std::memory_order_relaxed);
+    }
+
+    // 启用幽灵表，槽位数向上取整为 2 的幂，应在开始读写缓存之前设置
+    void enableGhost(size_t entries)
+    {
+        size_t slots = 2;
+        int bits = 1;
+        while (slots < entries)
+        {
+            slots <<= 1;
+            bits++;
+        }
+        ghost_.assign(slots, 0);
+        ghostShift_ = 64 - bits;
+    }
+
+    // 累计的幽灵命中数，即因容量不足而错失的读取
+    size_t getGhostHitCount() const
+    {
+        return ghostHitCount_.load(std::memory_order_relaxed);
+    }
+
+    int getCapacity() const
+    {
+        return capacity_.load(std::memory_order_relaxed);
+    }
+
+    // 调整容量，缩小时立即淘汰多出的最久未访问条目
+    void setCapacity(int capacity)
+    {
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_.store(capacity, std::memory_order_relaxed);
+        while (!nodeMap_.empty() && nodeMap_.size() > static_cast<size_t>(std::max(capacity, 0)))
+            evictLeastRecent();
+    }
+
+    // 注册移除通知器，应在开始读写缓存之前设置
+    void setRemovalNotifier(std::shared_ptr<RemovalNotifier> notifier)
+    {
+        notifier_ = std::move(notifier);
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value);
+    }
+
+    void put(const Key & key, Value && value) override
     {
-        if (capacity_ <= 0)
+        putImpl(key, std::move(value));
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        putImpl(std::move(key), std::move(value));
+    }
+
+    // 就地构造 value，已存在时以新构造的值替换
+    template <typename... Args>
+    void emplace(const Key & key, Args &&... args)
+    {
+        if (capacity_.load(std::memory_order_relaxed) <= 0)
             return;
 
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end())
         {
-            updateExistingNode(it->second, value);
+            updateExistingNode(it->second, Value(std::forward<Args>(args)...));
             return;
         }
 
-        addNewNode(key, value);
+        addNewNode(std::make_shared<LruNodeType>(std::in_place, key, std::forward<Args>(args)...));
+    }
+
+    bool get(const Key & key, Value & value) override
+    {
+        return getImpl(key, value);
+    }
+
+    template <typename K> requires FHeterogeneousKey<Key, K>
+    bool get(const K & key, Value & value)
+    {
+        return getImpl(key, value);
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
     }
 
-    bool get(Key key, Value & value) override
+    // 零拷贝读取：锁内只做索引与链表调整，未命中时返回空句柄
+    template <typename K>
+    ValueHandle getHandle(const K & key)
     {
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end())
         {
             moveToMostRecent(it->second);
-            value = it->second->getValue();
-            return true;
+            return ValueHandle(it->second);
         }
-        return false;
+        return ValueHandle();
     }
 
-    Value get(Key key) override
+    // 只刷新 key 的最近访问位置，不读取 value；key 不在缓存中时返回 false
+    template <typename K>
+    bool touch(const K & key)
     {
-        Value value{};
-        get(key, value);
-        return value;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end())
+            return false;
+
+        moveToMostRecent(it->second);
+        return true;
     }
 
-    void remove(Key key)
+    template <typename K>
+    void remove(const K & key)
     {
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = nodeMap_.find(key);
         if (it != nodeMap_.end())
         {
+            if (notifier_)
+                notifier_->enqueue(it->second->getKey(), it->second->takeValue(), FRemovalCause::Explicit);
             removeNode(it->second);
             nodeMap_.erase(it);
         }
     }
 
+protected:
+    // key 已在缓存中时更新其值并返回 true；否则不触碰 value 并返回 false
+    template <typename V>
+    bool assignIfPresent(const Key & key, V && value)
+    {
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end())
+            return false;
+
+        updateExistingNode(it->second, std::forward<V>(value));
+        return true;
+    }
+
 private:
+    template <typename K, typename V>
+    void putImpl(K && key, V && value)
+    {
+        if (capacity_.load(std::memory_order_relaxed) <= 0)
+            return;
+
+        FRemovalDispatch<Key, Value> dispatch(notifier_.get());
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            updateExistingNode(it->second, std::forward<V>(value));
+            return;
+        }
+
+        addNewNode(std::make_shared<LruNodeType>(std::forward<K>(key), std::forward<V>(value)));
+    }
+
+    template <typename K>
+    bool getImpl(const K & key, Value & value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            moveToMostRecent(it->second);
+            value = it->second->getValue();
+            return true;
+        }
+
+        if (!ghost_.empty())
+            consumeGhost(FHash<Key>{}(key));
+        return false;
+    }
+
     void initializeList()
     {
         dummyHead_ = std::make_shared<LruNodeType>(Key(), Value());
@@ -133,23 +293,63 @@ private:
     void evictLeastRecent()
     {
         NodePtr leastRecent = dummyHead_->next_;
+        if (notifier_)
+            notifier_->enqueue(leastRecent->getKey(), leastRecent->takeValue(), FRemovalCause::Size);
         removeNode(leastRecent);
+        if (!ghost_.empty())
+            recordGhost(FHash<Key>{}(leastRecent->getKey()));
         nodeMap_.erase(leastRecent->getKey());
+        evictionCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 指纹最低位恒为 1，与空槽位 0 区分；乘法散列取高位，避免分片后低位相同
+    size_t & ghostSlot(size_t hash)
+    {
+        return ghost_[(hash * 0x9E3779B97F4A7C15ULL) >> ghostShift_];
+    }
+
+    void recordGhost(size_t hash)
+    {
+        ghostSlot(hash) = hash | 1;
     }
 
-    void addNewNode(const Key & key, const Value & value)
+    // 每次淘汰至多计一次幽灵命中
+    void consumeGhost(size_t hash)
     {
-        if (nodeMap_.size() >= capacity_)
+        size_t & slot = ghostSlot(hash);
+        if (slot == (hash | 1))
+        {
+            slot = 0;
+            ghostHitCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 节点已持有 key 与 value，索引从节点复制 key
+    void addNewNode(NodePtr newNode)
+    {
+        if (nodeMap_.size() >= static_cast<size_t>(capacity_.load(std::memory_order_relaxed)))
             evictLeastRecent();
 
-        NodePtr newNode = std::make_shared<LruNodeType>(key, value);
         insertNode(newNode);
-        nodeMap_[key] = newNode;
+        nodeMap_.emplace(newNode->getKey(), newNode);
     }
 
-    void updateExistingNode(NodePtr node, const Value & value)
+    template <typename V>
+    void updateExistingNode(NodePtr & node, V && value)
     {
-        node->setValue(value);
+        if (notifier_)
+            notifier_->enqueue(node->getKey(), node->takeValue(), FRemovalCause::Replaced);
+
+        // 节点被句柄钉住时不能原地改写，换上新节点，旧节点随最后一个句柄释放
+        if (node->isPinned())
+        {
+            removeNode(node);
+            node = std::make_shared<LruNodeType>(node->getKey(), std::forward<V>(value));
+            insertNode(node);
+            return;
+        }
+
+        node->setValue(std::forward<V>(value));
         moveToMostRecent(node);
     }
 };
@@ -161,11 +361,13 @@ class FLruKCache : public FLruCache<Key, Value>
 private:
     int     k_;
     std::unique_ptr<FLruCache<Key, size_t>> accessCountList_; // 累计访问计数器
-    std::unordered_map<Key, Value> pendingValueMap_; // 待定区数据存放区
+    FIndexMap<Key, Value> pendingValueMap_; // 待定区数据存放区
 private:
     // 禁用基类方法操作主缓存数据
     using FLruCache<Key, Value>::get;
     using FLruCache<Key, Value>::put;
+    using FLruCache<Key, Value>::emplace;
+    using FLruCache<Key, Value>::getHandle; // 待定区数据不在节点中，不提供句柄读取
 public:
     FLruKCache(int capacity, int accessCountCapacity, int k)
         : FLruCache<Key, Value>(capacity)
@@ -173,7 +375,53 @@ public:
         , k_(k)
     {}
 
-    bool get(Key key, Value & value)
+    bool get(const Key & key, Value & value) override
+    {
+        return getImpl(key, value);
+    }
+
+    template <typename K> requires FHeterogeneousKey<Key, K>
+    bool get(const K & key, Value & value)
+    {
+        return getImpl(key, value);
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value);
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        putImpl(key, std::move(value));
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        putImpl(std::move(key), std::move(value));
+    }
+
+    // 主缓存与待定区一并删除，否则待定区的旧值仍会被读到
+    template <typename K>
+    void remove(const K & key)
+    {
+        FLruCache<Key, Value>::remove(key);
+        accessCountList_->remove(key);
+        auto it = pendingValueMap_.find(key);
+        if (it != pendingValueMap_.end())
+            pendingValueMap_.erase(it);
+    }
+
+private:
+    template <typename K>
+    bool getImpl(const K & key, Value & value)
     {
         // 首先尝试从主缓存获取数据
         bool inMainCache = FLruCache<Key, Value>::get(key, value);
@@ -183,33 +431,31 @@ public:
         // 尝试从等待区获取数据
         size_t accessCount;
         bool inPendingList = accessCountList_->get(key, accessCount);
+        auto it = pendingValueMap_.find(key);
         if (inPendingList)
         {
             accessCount++;
-            auto it = pendingValueMap_.find(key);
             value = it->second;
             if (accessCount >= k_)
             {
                 // 将数据从等待区移动到主缓存
-                moveFromPendingToMainCache(key, value);
+                moveFromPendingToMainCache(it);
             }
             return true;
         }
 
         // 缓存中不存在该数据
-        pendingValueMap_.erase(key);
+        if (it != pendingValueMap_.end())
+            pendingValueMap_.erase(it);
         return false;
     }
 
-    void put(Key key, Value value)
+    template <typename K, typename V>
+    void putImpl(K && key, V && value)
     {
         // 首先尝试将数据放入主缓存
-        bool inMainCache = FLruCache<Key, Value>::get(key, value);
-        if (inMainCache)
-        {
-            FLruCache<Key, Value>::put(key, value);
+        if (this->assignIfPresent(key, std::forward<V>(value)))
             return;
-        }
 
         // 操作等待区
         size_t accessCount = accessCountList_->get(key);
@@ -217,22 +463,421 @@ public:
         // 该数据已达标
         if (accessCount >= k_)
         {
-            // 将数据从等待区移动到主缓存
-            moveFromPendingToMainCache(key, value);
+            // 将数据直接放入主缓存
+            auto it = pendingValueMap_.find(key);
+            if (it != pendingValueMap_.end())
+                pendingValueMap_.erase(it);
+            accessCountList_->remove(key);
+            FLruCache<Key, Value>::put(std::forward<K>(key), std::forward<V>(value));
             return;
         }
         // 数据未达标
         accessCountList_->put(key, accessCount);
-        pendingValueMap_[key] = value;
+        pendingValueMap_.insert_or_assign(std::forward<K>(key), std::forward<V>(value));
+    }
 
+    // 从待定区摘下节点，把 key 与 value 移入主缓存
+    void moveFromPendingToMainCache(typename FIndexMap<Key, Value>::iterator it)
+    {
+        auto pending = pendingValueMap_.extract(it);
+        accessCountList_->remove(pending.key());
+        FLruCache<Key, Value>::put(std::move(pending.key()), std::move(pending.mapped()));
     }
+};
 
+// 以 LruNode 组成的双向链表，头部为最久未访问
+template <typename Key, typename Value>
+class LruNodeList
+{
 private:
-    void moveFromPendingToMainCache(const Key & key, const Value & value)
+    using NodePtr = std::shared_ptr<LruNode<Key, Value>>;
+
+    NodePtr dummyHead_;
+    NodePtr dummyTail_;
+    size_t  size_;
+
+public:
+    LruNodeList()
+        : size_(0)
     {
-        pendingValueMap_.erase(key);
-        accessCountList_->remove(key);
-        FLruCache<Key, Value>::put(key, value);
+        dummyHead_ = std::make_shared<LruNode<Key, Value>>(Key(), Value());
+        dummyTail_ = std::make_shared<LruNode<Key, Value>>(Key(), Value());
+        dummyHead_->next_ = dummyTail_;
+        dummyTail_->prev_ = dummyHead_;
+    }
+
+    bool isEmpty() const
+    {
+        return size_ == 0;
+    }
+
+    void insert(NodePtr node)
+    {
+        node->next_ = dummyTail_;
+        node->prev_ = dummyTail_->prev_;
+        dummyTail_->prev_.lock()->next_ = node;
+        dummyTail_->prev_ = node;
+        ++size_;
+    }
+
+    void remove(NodePtr node)
+    {
+        if (!node->prev_.expired() && node->next_)
+        {
+            auto prev = node->prev_.lock();
+            prev->next_ = node->next_;
+            node->next_->prev_ = prev;
+            node->next_ = nullptr;
+            --size_;
+        }
+    }
+
+    NodePtr getLeastRecent() const
+    {
+        return dummyHead_->next_;
+    }
+
+    size_t getSize() const
+    {
+        return size_;
+    }
+};
+
+// 分段 LRU（SLRU）：新数据进入试用段，试用段中再次命中才晋升到保护段，顺序扫描只会冲刷试用段
+template <typename Key, typename Value>
+class FSlruCache : public FCachePolicy<Key, Value>
+{
+private:
+    using LruNodeType = LruNode<Key, Value>;
+    using NodePtr = std::shared_ptr<LruNodeType>;
+    using NodeList = LruNodeList<Key, Value>;
+
+    struct Slot
+    {
+        NodePtr node;
+        bool    isProtected;
+    };
+    using NodeMap = FIndexMap<Key, Slot>;
+public:
+    using ValueHandle = FValueHandle<Value, LruNodeType>;
+private:
+    size_t  capacity_;
+    size_t  protectedCapacity_;
+    NodeMap nodeMap_;
+    NodeList probationList_;
+    NodeList protectedList_;
+    std::mutex mutex_;
+    std::atomic<size_t> evictionCount_{0};
+public:
+    // protectedRatio 为保护段占总容量的比例
+    FSlruCache(size_t capacity, double protectedRatio = 0.8)
+        : capacity_(capacity)
+        , protectedCapacity_(static_cast<size_t>(capacity * protectedRatio))
+    {
+        if (capacity_ > 0 && protectedCapacity_ >= capacity_)
+            protectedCapacity_ = capacity_ - 1;
+    }
+
+    ~FSlruCache() override = default;
+
+    size_t getEvictionCount() const override
+    {
+        return evictionCount_.load(std::memory_order_relaxed);
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value);
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        putImpl(key, std::move(value));
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        putImpl(std::move(key), std::move(value));
+    }
+
+    // 就地构造 value；复用淘汰节点时退化为构造后移动赋值
+    template <typename... Args>
+    void emplace(const Key & key, Args &&... args)
+    {
+        if (capacity_ == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            updateExistingNode(it->second, Value(std::forward<Args>(args)...));
+            touch(it->second);
+            return;
+        }
+
+        NodePtr node = recycleVictim();
+        if (node)
+        {
+            node->setKey(key);
+            node->setValue(Value(std::forward<Args>(args)...));
+        }
+        else
+        {
+            node = std::make_shared<LruNodeType>(std::in_place, key, std::forward<Args>(args)...);
+        }
+        addNewNode(node);
+    }
+
+    bool get(const Key & key, Value & value) override
+    {
+        return getImpl(key, value);
+    }
+
+    template <typename K> requires FHeterogeneousKey<Key, K>
+    bool get(const K & key, Value & value)
+    {
+        return getImpl(key, value);
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
+    }
+
+    template <typename K>
+    ValueHandle getHandle(const K & key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            touch(it->second);
+            return ValueHandle(it->second.node);
+        }
+        return ValueHandle();
+    }
+
+    template <typename K>
+    void remove(const K & key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            listOf(it->second).remove(it->second.node);
+            nodeMap_.erase(it);
+        }
+    }
+
+private:
+    template <typename K, typename V>
+    void putImpl(K && key, V && value)
+    {
+        if (capacity_ == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            updateExistingNode(it->second, std::forward<V>(value));
+            touch(it->second);
+            return;
+        }
+
+        NodePtr node = recycleVictim();
+        if (node)
+        {
+            node->setKey(std::forward<K>(key));
+            node->setValue(std::forward<V>(value));
+        }
+        else
+        {
+            node = std::make_shared<LruNodeType>(std::forward<K>(key), std::forward<V>(value));
+        }
+        addNewNode(node);
+    }
+
+    template <typename K>
+    bool getImpl(const K & key, Value & value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end())
+        {
+            touch(it->second);
+            value = it->second.node->getValue();
+            return true;
+        }
+        return false;
+    }
+
+    NodeList & listOf(const Slot & slot)
+    {
+        return slot.isProtected ? protectedList_ : probationList_;
+    }
+
+    // 命中：试用段晋升到保护段，保护段溢出时把其最久未访问者降回试用段
+    void touch(Slot & slot)
+    {
+        if (slot.isProtected)
+        {
+            protectedList_.remove(slot.node);
+            protectedList_.insert(slot.node);
+            return;
+        }
+
+        probationList_.remove(slot.node);
+        if (protectedCapacity_ == 0)
+        {
+            probationList_.insert(slot.node);
+            return;
+        }
+
+        if (protectedList_.getSize() >= protectedCapacity_)
+        {
+            NodePtr demoted = protectedList_.getLeastRecent();
+            protectedList_.remove(demoted);
+            probationList_.insert(demoted);
+            nodeMap_.find(demoted->getKey())->second.isProtected = false;
+        }
+        protectedList_.insert(slot.node);
+        slot.isProtected = true;
+    }
+
+    // 被句柄钉住的节点换成新节点，保持句柄所见的值不变
+    template <typename V>
+    void updateExistingNode(Slot & slot, V && value)
+    {
+        if (!slot.node->isPinned())
+        {
+            slot.node->setValue(std::forward<V>(value));
+            return;
+        }
+
+        NodeList & list = listOf(slot);
+        list.remove(slot.node);
+        slot.node = std::make_shared<LruNodeType>(slot.node->getKey(), std::forward<V>(value));
+        list.insert(slot.node);
+    }
+
+    // 满时淘汰一个节点，未被句柄钉住则交给新数据复用，稳态下插入不再分配节点
+    NodePtr recycleVictim()
+    {
+        if (nodeMap_.size() < capacity_)
+            return nullptr;
+
+        NodeList & victimList = probationList_.isEmpty() ? protectedList_ : probationList_;
+        NodePtr victim = victimList.getLeastRecent();
+        victimList.remove(victim);
+        nodeMap_.erase(victim->getKey());
+        evictionCount_.fetch_add(1, std::memory_order_relaxed);
+        return victim->isPinned() ? nullptr : victim;
+    }
+
+    void addNewNode(NodePtr node)
+    {
+        probationList_.insert(node);
+        nodeMap_.emplace(node->getKey(), Slot{node, false});
+    }
+};
+
+// 近端缓存统计：近端命中 / 共享层命中 / 未命中（含已退出线程的累计值），以及仍存活的线程近端表数
+struct NearCacheStats
+{
+    size_t nearHits;
+    size_t sharedHits;
+    size_t misses;
+    size_t liveTables;
+};
+
+// 线程本地的近端缓存表：直接映射，每个槽位记录读入时 key 所在版本条带的版本号
+template <typename Key, typename Value>
+class NearCacheTable
+{
+public:
+    struct Entry
+    {
+        Key      key;
+        Value    value;
+        uint64_t version;
+        uint32_t hitsSinceTouch = 0; // 近端命中不经过共享层，累计到一定次数再去刷新一次共享层的 LRU 位置
+        bool     valid = false;
+    };
+
+    std::vector<Entry> entries_;
+    size_t mask_;
+    // 仅由所属线程写入，relaxed 原子量只为让统计线程安全地读取
+    std::atomic<size_t> nearHits_;
+    std::atomic<size_t> sharedHits_;
+    std::atomic<size_t> misses_;
+
+public:
+    explicit NearCacheTable(size_t capacity)
+        : entries_(capacity)
+        , mask_(capacity - 1)
+        , nearHits_(0)
+        , sharedHits_(0)
+        , misses_(0)
+    {}
+
+    Entry & slot(size_t hash)
+    {
+        return entries_[hash & mask_];
+    }
+
+    static void count(std::atomic<size_t> & counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// 一个缓存实例的全部近端表：由缓存实例持有，线程退出时摘除自己的表并把计数并入累计值，
+// 这样实例与线程谁先结束都不会留下无主的表
+template <typename Key, typename Value>
+class NearCacheRegistry
+{
+private:
+    using NearTable = NearCacheTable<Key, Value>;
+
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<NearTable>> tables_;
+    NearCacheStats retired_{0, 0, 0, 0};
+public:
+    void attach(std::shared_ptr<NearTable> table)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tables_.push_back(std::move(table));
+    }
+
+    void detach(const NearTable * table)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(tables_.begin(), tables_.end(), [table](const auto & t) { return t.get() == table; });
+        if (it == tables_.end())
+            return;
+        retired_.nearHits += (*it)->nearHits_.load(std::memory_order_relaxed);
+        retired_.sharedHits += (*it)->sharedHits_.load(std::memory_order_relaxed);
+        retired_.misses += (*it)->misses_.load(std::memory_order_relaxed);
+        *it = std::move(tables_.back());
+        tables_.pop_back();
+    }
+
+    NearCacheStats stats()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        NearCacheStats stats = retired_;
+        for (const auto & table : tables_)
+        {
+            stats.nearHits += table->nearHits_.load(std::memory_order_relaxed);
+            stats.sharedHits += table->sharedHits_.load(std::memory_order_relaxed);
+            stats.misses += table->misses_.load(std::memory_order_relaxed);
+        }
+        stats.liveTables = tables_.size();
+        return stats;
     }
 };
 
@@ -241,46 +886,345 @@ template<typename Key, typename Value>
 class FHashLruCache : public FCachePolicy<Key, Value>
 {
 private:
+    using NearTable = NearCacheTable<Key, Value>;
+    using NearTablePtr = std::shared_ptr<NearTable>;
+    using NearRegistry = NearCacheRegistry<Key, Value>;
+public:
+    using ValueHandle = typename FLruCache<Key, Value>::ValueHandle;
+private:
+
+    static const size_t VERSION_STRIPES = 4096;
+    static const uint64_t REBALANCE_INTERVAL = 4096; // 单个分片每经过这么多次共享层操作尝试一次再平衡
+    static const size_t MIN_GHOST_SIGNAL = 8;        // 幽灵命中差距低于此值时不挪动容量
+    static const uint32_t NEAR_TOUCH_INTERVAL = 16;  // 同一近端副本每命中这么多次刷新一次共享层分片中的位置
+
     size_t  capacity_;
     int     sliceNum_;
     std::vector<std::unique_ptr<FLruCache<Key, Value>>> lruSliceCaches_;
+
+    // 自适应容量：分片按幽灵命中（因容量不足而错失的读取）互相借还容量，总量不变
+    struct alignas(64) SliceTicks
+    {
+        std::atomic<uint64_t> ops{0};
+    };
+    bool    rebalance_;
+    size_t  baseSliceCapacity_;
+    std::unique_ptr<SliceTicks[]> sliceTicks_;
+    std::mutex rebalanceMutex_;           // 只在再平衡线程之间互斥，读写路径用 try_lock 从不等待
+    std::vector<size_t> lastGhostHits_;   // 上一轮再平衡时各分片的幽灵命中数
+
+    // 近端缓存（nearCapacity 为 0 时关闭）
+    size_t  nearCapacity_;
+    uint64_t instanceId_;
+    std::unique_ptr<std::atomic<uint64_t>[]> versions_; // put/remove 时递增，使各线程的近端副本失效
+    std::shared_ptr<NearRegistry> nearRegistry_;
 public:
-    FHashLruCache(size_t capacity, int sliceNum)
+    // rebalance 为 true 时各分片按未命中压力自适应调整容量
+    FHashLruCache(size_t capacity, int sliceNum, size_t nearCapacity = 0, bool rebalance = false)
         : capacity_(capacity)
         , sliceNum_(sliceNum)
+        , rebalance_(rebalance && sliceNum > 1)
+        , baseSliceCapacity_(0)
+        , nearCapacity_(0)
+        , instanceId_(nextInstanceId())
         {
             size_t sliceCapacity = std::ceil(capacity / static_cast<double>(sliceNum_));
+            baseSliceCapacity_ = sliceCapacity;
             for (int i = 0; i < sliceNum_; ++i)
             {
                 lruSliceCaches_.emplace_back(std::make_unique<FLruCache<Key, Value>>(sliceCapacity));
+                if (rebalance_)
+                    lruSliceCaches_.back()->enableGhost(sliceCapacity);
+            }
+
+            if (rebalance_)
+            {
+                sliceTicks_ = std::make_unique<SliceTicks[]>(sliceNum_);
+                lastGhostHits_.assign(sliceNum_, 0);
+            }
+
+            if (nearCapacity > 0)
+            {
+                // 槽位数向上取整为 2 的幂
+                nearCapacity_ = 1;
+                while (nearCapacity_ < nearCapacity)
+                    nearCapacity_ <<= 1;
+                versions_ = std::make_unique<std::atomic<uint64_t>[]>(VERSION_STRIPES);
+                nearRegistry_ = std::make_shared<NearRegistry>();
+                for (size_t i = 0; i < VERSION_STRIPES; ++i)
+                    versions_[i].store(0, std::memory_order_relaxed);
             }
         }
 
-    bool get(Key key, Value & value) override
+    bool get(const Key & key, Value & value) override
     {
-        size_t sliceIndex = Hash(key) % sliceNum_;
-        return lruSliceCaches_[sliceIndex]->get(key, value);
+        return getImpl(key, value);
+    }
+
+    template <typename K> requires FHeterogeneousKey<Key, K>
+    bool get(const K & key, Value & value)
+    {
+        return getImpl(key, value);
     }
 
-    Value get(Key key) override
+    Value get(const Key & key) override
     {
         Value value{};
         get(key, value);
         return value;
     }
 
-    void put(Key key, Value value) override
+    // 句柄直接取自共享层分片，不经过近端缓存
+    template <typename K>
+    ValueHandle getHandle(const K & key)
     {
         size_t sliceIndex = Hash(key) % sliceNum_;
-        return lruSliceCaches_[sliceIndex]->put(key, value);
+        return lruSliceCaches_[sliceIndex]->getHandle(key);
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value);
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        putImpl(key, std::move(value));
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        putImpl(std::move(key), std::move(value));
+    }
+
+    template <typename... Args>
+    void emplace(const Key & key, Args &&... args)
+    {
+        size_t hash = Hash(key);
+        size_t sliceIndex = hash % sliceNum_;
+        lruSliceCaches_[sliceIndex]->emplace(key, std::forward<Args>(args)...);
+        invalidateNear(hash);
+    }
+
+    template <typename K>
+    void remove(const K & key)
+    {
+        size_t hash = Hash(key);
+        size_t sliceIndex = hash % sliceNum_;
+        lruSliceCaches_[sliceIndex]->remove(key);
+        invalidateNear(hash);
+    }
+
+    size_t getEvictionCount() const override
+    {
+        size_t count = 0;
+        for (const auto & slice : lruSliceCaches_)
+            count += slice->getEvictionCount();
+        return count;
+    }
+
+    // 各分片共享同一个通知器，回调仍在分片锁之外执行
+    void setRemovalNotifier(std::shared_ptr<FRemovalNotifier<Key, Value>> notifier)
+    {
+        for (auto & slice : lruSliceCaches_)
+            slice->setRemovalNotifier(notifier);
+    }
+
+    // 各分片当前容量，总和保持为构造时的分片容量之和
+    std::vector<size_t> getSliceCapacities() const
+    {
+        std::vector<size_t> capacities;
+        for (const auto & slice : lruSliceCaches_)
+            capacities.push_back(slice->getCapacity());
+        return capacities;
+    }
+
+    // 汇总所有线程（含已退出的线程）的近端 / 共享层命中分布
+    NearCacheStats getNearCacheStats()
+    {
+        if (!nearRegistry_)
+            return NearCacheStats{0, 0, 0, 0};
+        return nearRegistry_->stats();
     }
 
 private:
-        size_t Hash(Key key)
+    template <typename K>
+    bool getImpl(const K & key, Value & value)
+    {
+        size_t hash = Hash(key);
+        size_t sliceIndex = hash % sliceNum_;
+        if (nearCapacity_ == 0)
+        {
+            tick(sliceIndex);
+            return lruSliceCaches_[sliceIndex]->get(key, value);
+        }
+
+        // 先读版本号再访问共享层，期间若有写入则副本会带着旧版本号，下次访问即失效
+        NearTable & table = localNearTable();
+        uint64_t version = versions_[hash & (VERSION_STRIPES - 1)].load(std::memory_order_acquire);
+        auto & entry = table.slot(hash);
+        if (entry.valid && entry.version == version && entry.key == key)
+        {
+            value = entry.value;
+            NearTable::count(table.nearHits_);
+            // 最热的 key 几乎只在近端命中，定期刷新共享层，避免它在分片 LRU 中老化被淘汰
+            if (++entry.hitsSinceTouch >= NEAR_TOUCH_INTERVAL)
+            {
+                entry.hitsSinceTouch = 0;
+                if (!lruSliceCaches_[sliceIndex]->touch(key))
+                    entry.valid = false; // 共享层已淘汰该 key，近端副本不再保留
+            }
+            return true;
+        }
+
+        tick(sliceIndex);
+        if (!lruSliceCaches_[sliceIndex]->get(key, value))
+        {
+            NearTable::count(table.misses_);
+            return false;
+        }
+
+        entry.key = key;
+        entry.value = value;
+        entry.version = version;
+        entry.hitsSinceTouch = 0;
+        entry.valid = true;
+        NearTable::count(table.sharedHits_);
+        return true;
+    }
+
+    template <typename K, typename V>
+    void putImpl(K && key, V && value)
+    {
+        size_t hash = Hash(key);
+        size_t sliceIndex = hash % sliceNum_;
+        tick(sliceIndex);
+        lruSliceCaches_[sliceIndex]->put(std::forward<K>(key), std::forward<V>(value));
+        invalidateNear(hash);
+    }
+
+    // 计数落在分片自己的缓存行上，不引入全局争用
+    void tick(size_t sliceIndex)
+    {
+        if (!rebalance_)
+            return;
+
+        uint64_t ops = sliceTicks_[sliceIndex].ops.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (ops % REBALANCE_INTERVAL == 0)
+            rebalance();
+    }
+
+    // 按本轮幽灵命中数排序，由最高与最低的分片两两配对，低者先缩容、高者再扩容；
+    // 每次只挪动一小份，负载回落后容量会按同样的信号流回
+    void rebalance()
+    {
+        std::unique_lock<std::mutex> lock(rebalanceMutex_, std::try_to_lock);
+        if (!lock.owns_lock())
+            return;
+
+        std::vector<size_t> pressure(sliceNum_);
+        for (int i = 0; i < sliceNum_; ++i)
         {
-            std::hash<Key> hashFunc;
+            size_t ghostHits = lruSliceCaches_[i]->getGhostHitCount();
+            pressure[i] = ghostHits - lastGhostHits_[i];
+            lastGhostHits_[i] = ghostHits;
+        }
+
+        // 压力相同时容量大的排在后面，优先作为出借方
+        std::vector<size_t> capacities = getSliceCapacities();
+        std::vector<int> order(sliceNum_);
+        for (int i = 0; i < sliceNum_; ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return pressure[a] != pressure[b] ? pressure[a] > pressure[b] : capacities[a] < capacities[b];
+        });
+
+        size_t quantum = std::max<size_t>(1, baseSliceCapacity_ / 16);
+        size_t minCapacity = std::max<size_t>(1, baseSliceCapacity_ / 64);
+        int pairs = std::max(1, sliceNum_ / 4);
+        int lo = sliceNum_ - 1;
+        for (int p = 0; p < pairs && p < lo; ++p)
+        {
+            // 跳过已缩到下限的出借方
+            while (lo > p && capacities[order[lo]] < minCapacity + quantum)
+                lo--;
+            if (lo <= p)
+                break;
+
+            int hot = order[p];
+            int cold = order[lo--];
+            if (pressure[hot] < 2 * pressure[cold] + MIN_GHOST_SIGNAL)
+                break;
+
+            lruSliceCaches_[cold]->setCapacity(capacities[cold] - quantum);
+            lruSliceCaches_[hot]->setCapacity(capacities[hot] + quantum);
+        }
+    }
+
+        template <typename K>
+        size_t Hash(const K & key)
+        {
+            FHash<Key> hashFunc;
             return hashFunc(key);
         }
+
+        void invalidateNear(size_t hash)
+        {
+            if (nearCapacity_ > 0)
+                versions_[hash & (VERSION_STRIPES - 1)].fetch_add(1, std::memory_order_release);
+        }
+
+        // 线程本地只记录本线程在各实例中的表，表本身归实例的注册表所有：实例销毁后表随之释放，
+        // 线程退出时析构函数把表从仍存活的实例中摘除
+        struct NearTableBinding
+        {
+            std::weak_ptr<NearRegistry> registry;
+            NearTable * table;
+        };
+
+        struct LocalNearTables
+        {
+            std::unordered_map<uint64_t, NearTableBinding> bindings;
+
+            ~LocalNearTables()
+            {
+                for (const auto & [id, binding] : bindings)
+                {
+                    if (auto registry = binding.registry.lock())
+                        registry->detach(binding.table);
+                }
+            }
+        };
+
+        // 每个线程为每个缓存实例持有一张表，以实例 id 而非地址区分，避免地址复用导致串表；
+        // 已销毁实例的绑定在下次建表时清理
+        NearTable & localNearTable()
+        {
+            thread_local LocalNearTables local;
+            thread_local uint64_t lastId = 0;
+            thread_local NearTable * lastTable = nullptr;
+            if (lastTable != nullptr && lastId == instanceId_)
+                return *lastTable;
+
+            auto & bindings = local.bindings;
+            auto it = bindings.find(instanceId_);
+            if (it == bindings.end())
+            {
+                std::erase_if(bindings, [](const auto & item) { return item.second.registry.expired(); });
+                auto table = std::make_shared<NearTable>(nearCapacity_);
+                nearRegistry_->attach(table);
+                it = bindings.emplace(instanceId_, NearTableBinding{nearRegistry_, table.get()}).first;
+            }
+            lastId = instanceId_;
+            lastTable = it->second.table;
+            return *lastTable;
+        }
+
+        static uint64_t nextInstanceId()
+        {
+            static std::atomic<uint64_t> counter(0);
+            return ++counter;
+        }
 };
 
 } // namespace FreddyCache
\ No newline at end of file
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FreddyCache
+{
+
+// 条目离开缓存的原因
+enum class FRemovalCause
+{
+    Size,       // 容量不足被淘汰
+    Expired,    // 过期（供带 TTL 的策略使用）
+    Explicit,   // 调用 remove 主动删除
+    Replaced,   // 被同 key 的新值覆盖
+};
+
+template <typename Key, typename Value>
+struct FRemovalEvent
+{
+    Key           key;
+    Value         value;
+    FRemovalCause cause;
+};
+
+// 移除事件的投递模式
+enum class FDeliveryMode
+{
+    Inline,     // 由触发移除的线程在释放缓存锁后投递
+    Background, // 由通知器自带的后台线程投递
+};
+
+// 移除通知器：缓存在持锁期间只把事件追加到队列，回调一律在缓存锁与通知器的锁之外成批执行。
+// 同一时刻只有一个线程在投递，同一通知器的回调串行执行，可被多个缓存（如各个分片）共享。
+// 入队发生在缓存锁内，从不阻塞；队列达到 maxPending 后，写入线程在释放缓存锁后等待投递方取走事件（背压），
+// 因此队列深度至多超出 maxPending 并发写入线程各自一次操作产生的事件数。
+// 内联模式下每个投递者只送出接手时已入队的一批，随即交给下一个写入者，不会被其他线程的持续写入拖住；
+// 投递期间其他线程入队而尚未满额的事件由之后的写入、flush 或析构送出。
+// 监听器内可以再写同一缓存：嵌套写入只入队、不等待，事件留待下一批送出。
+// 后台线程攒够一批或最多等待 MAX_DELIVERY_DELAY 后才被唤醒，避免每次淘汰都切换线程。监听器不应抛出异常。
+template <typename Key, typename Value>
+class FRemovalNotifier
+{
+public:
+    using Event = FRemovalEvent<Key, Value>;
+    using Listener = std::function<void(const std::vector<Event> &)>;
+private:
+    Listener      listener_;
+    size_t        maxPending_;
+    FDeliveryMode mode_;
+
+    static constexpr std::chrono::milliseconds MAX_DELIVERY_DELAY{10};
+
+    size_t        wakeThreshold_; // 后台模式下攒够该数量才唤醒后台线程
+
+    std::mutex    queueMutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;  // 队列被取走或一批投递完成时通知
+    std::vector<Event> pending_;
+    std::vector<Event> spare_;         // 内联投递者与 pending_ 交替使用，复用已分配的空间
+    std::atomic<size_t> pendingCount_; // pending_ 的大小，队列为空时读写路径据此跳过加锁
+    uint64_t      enqueued_;   // 累计入队的事件数
+    uint64_t      delivered_;  // 累计投递完成的事件数，flush 据此等待调用前入队的事件
+    size_t        flushing_;   // 正在 flush 的线程数，非零时后台线程立即投递
+    bool          delivering_; // 内联模式下已有线程在投递
+    bool          stopping_;
+
+    std::thread   worker_;
+public:
+    FRemovalNotifier(Listener listener, size_t maxPending = 1024, FDeliveryMode mode = FDeliveryMode::Inline)
+        : listener_(std::move(listener))
+        , maxPending_(maxPending > 0 ? maxPending : 1)
+        , mode_(mode)
+        , wakeThreshold_(std::min<size_t>(64, (maxPending_ + 1) / 2))
+        , pendingCount_(0)
+        , enqueued_(0)
+        , delivered_(0)
+        , flushing_(0)
+        , delivering_(false)
+        , stopping_(false)
+    {
+        if (mode_ == FDeliveryMode::Background)
+            worker_ = std::thread([this] { run(); });
+    }
+
+    ~FRemovalNotifier()
+    {
+        if (worker_.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                stopping_ = true;
+            }
+            notEmpty_.notify_one();
+            worker_.join();
+        }
+        // 剩余事件在析构线程中投递完，此时已没有并发的写入者
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        while (!pending_.empty())
+            deliverBatch(lock);
+    }
+
+    FRemovalNotifier(const FRemovalNotifier &) = delete;
+    FRemovalNotifier & operator=(const FRemovalNotifier &) = delete;
+
+    // 在缓存锁内调用：只入队，不阻塞、不执行回调
+    template <typename K, typename V>
+    void enqueue(K && key, V && value, FRemovalCause cause)
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        pending_.push_back(Event{std::forward<K>(key), std::forward<V>(value), cause});
+        ++enqueued_;
+        pendingCount_.store(pending_.size(), std::memory_order_release);
+    }
+
+    // 在缓存锁外调用：内联模式下接手投递一批，后台模式下唤醒后台线程；队列超限时等待
+    void dispatch()
+    {
+        if (mode_ == FDeliveryMode::Inline)
+        {
+            if (pendingCount_.load(std::memory_order_acquire) == 0 || deliveringOnThisThread())
+                return;
+
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            for (;;)
+            {
+                if (pending_.empty())
+                    return;
+                if (!delivering_)
+                {
+                    deliverBatch(lock);
+                    return;
+                }
+                if (pending_.size() < maxPending_)
+                    return;
+                notFull_.wait(lock);
+            }
+        }
+
+        if (pendingCount_.load(std::memory_order_acquire) < wakeThreshold_)
+            return;
+
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        notEmpty_.notify_one();
+        // 监听器在后台线程上写回缓存时不能等待自己
+        if (deliveringOnThisThread())
+            return;
+        notFull_.wait(lock, [this] { return pending_.size() < maxPending_ || stopping_; });
+    }
+
+    // 等待调用前入队的事件全部投递完成，之后其他线程入队的事件不在等待之列；
+    // 在监听器内调用时直接返回，嵌套产生的事件留待下一批
+    void flush()
+    {
+        if (deliveringOnThisThread())
+            return;
+
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        const uint64_t target = enqueued_;
+        if (mode_ == FDeliveryMode::Inline)
+        {
+            // 投递按入队顺序进行，没有投递者时由本线程接手，否则等当前这一批送完
+            while (delivered_ < target)
+            {
+                if (!delivering_)
+                    deliverBatch(lock);
+                else
+                    notFull_.wait(lock);
+            }
+            return;
+        }
+
+        ++flushing_;
+        notEmpty_.notify_one();
+        notFull_.wait(lock, [this, target] { return delivered_ >= target || stopping_; });
+        --flushing_;
+    }
+
+private:
+    // 当前线程正在为哪个通知器执行回调，用于识别监听器内的嵌套写入
+    static const FRemovalNotifier *& currentDelivery()
+    {
+        thread_local const FRemovalNotifier * current = nullptr;
+        return current;
+    }
+
+    bool deliveringOnThisThread() const
+    {
+        return currentDelivery() == this;
+    }
+
+    class DeliveryScope
+    {
+    private:
+        const FRemovalNotifier * previous_;
+    public:
+        explicit DeliveryScope(const FRemovalNotifier * notifier)
+            : previous_(currentDelivery())
+        {
+            currentDelivery() = notifier;
+        }
+
+        ~DeliveryScope()
+        {
+            currentDelivery() = previous_;
+        }
+    };
+
+    // 持 queueMutex_ 且无人投递、队列非空时调用：取走当前整批事件，解锁后调用监听器，
+    // 送完后重新加锁并交出投递权，返回时仍持锁
+    void deliverBatch(std::unique_lock<std::mutex> & lock)
+    {
+        delivering_ = true;
+        std::vector<Event> batch = std::move(spare_);
+        batch.swap(pending_);
+        pendingCount_.store(0, std::memory_order_relaxed);
+        notFull_.notify_all();
+        lock.unlock();
+
+        {
+            DeliveryScope scope(this);
+            if (listener_)
+                listener_(batch);
+        }
+
+        lock.lock();
+        delivered_ += batch.size();
+        batch.clear();
+        spare_ = std::move(batch);
+        delivering_ = false;
+        notFull_.notify_all();
+    }
+
+    void run()
+    {
+        DeliveryScope scope(this);
+        std::vector<Event> batch; // 与 pending_ 交替使用，复用已分配的空间
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        for (;;)
+        {
+            notEmpty_.wait_for(lock, MAX_DELIVERY_DELAY, [this] {
+                return stopping_ || pending_.size() >= wakeThreshold_ || (flushing_ > 0 && !pending_.empty());
+            });
+            if (pending_.empty())
+            {
+                if (stopping_)
+                    return;
+                continue;
+            }
+
+            batch.swap(pending_);
+            pendingCount_.store(0, std::memory_order_relaxed);
+            notFull_.notify_all();
+            lock.unlock();
+
+            if (listener_)
+                listener_(batch);
+
+            lock.lock();
+            delivered_ += batch.size();
+            batch.clear();
+            notFull_.notify_all();
+        }
+    }
+};
+
+// 声明在缓存锁之前，析构时缓存锁已释放，再投递本次操作产生的事件
+template <typename Key, typename Value>
+class FRemovalDispatch
+{
+private:
+    FRemovalNotifier<Key, Value> * notifier_;
+public:
+    explicit FRemovalDispatch(FRemovalNotifier<Key, Value> * notifier)
+        : notifier_(notifier)
+    {}
+
+    ~FRemovalDispatch()
+    {
+        if (notifier_)
+            notifier_->dispatch();
+    }
+
+    FRemovalDispatch(const FRemovalDispatch &) = delete;
+    FRemovalDispatch & operator=(const FRemovalDispatch &) = delete;
+};
+
+} // namespace FreddyCache
@@ -0,0 +1,505 @@
+#pragma once
+
+#include "FCachePolicy.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FreddyCache
+{
+
+// 跨进程共享的 Hash-LRU：索引、LRU 链表与数据全部位于同名 POSIX 共享内存段中，
+// 链接使用分片内的下标而非指针，各进程映射到不同地址也能共用；
+// 每个分片一把进程间共享的健壮锁，持锁进程崩溃后由下一个加锁者清空该分片恢复
+template <typename Key, typename Value>
+class FShmLruCache : public FCachePolicy<Key, Value>
+{
+    static_assert(std::is_trivially_copyable_v<Key>, "FShmLruCache requires a trivially copyable Key");
+    static_assert(std::is_trivially_copyable_v<Value>, "FShmLruCache requires a trivially copyable Value");
+
+private:
+    static const uint32_t NIL = UINT32_MAX;
+    static const uint64_t MAGIC = 0x46434143484553ULL; // "FCACHES"
+    static const uint32_t LAYOUT_VERSION = 1;
+
+    struct ShmHeader
+    {
+        uint64_t magic;
+        uint32_t layoutVersion;
+        uint32_t sliceNum;
+        uint32_t sliceCapacity;
+        uint32_t bucketCount;
+        uint64_t entrySize;
+        uint64_t totalBytes;
+        std::atomic<uint32_t> ready;
+    };
+
+    struct alignas(64) ShmShard
+    {
+        pthread_mutex_t mutex;
+        uint32_t head;      // 最久未访问
+        uint32_t tail;      // 最近访问
+        uint32_t freeHead;  // 空闲条目链表
+        uint32_t size;
+        uint64_t recoveries; // 因持锁进程崩溃而重置的次数
+    };
+
+    struct ShmEntry
+    {
+        Key      key;
+        Value    value;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t chainNext; // 哈希桶冲突链
+    };
+
+    std::string name_;
+    char *   base_;
+    size_t   totalBytes_;
+    uint32_t sliceNum_;
+    uint32_t sliceCapacity_;
+    uint32_t bucketCount_;
+    size_t   shardsOffset_;
+    size_t   slicesOffset_;
+    size_t   sliceBytes_;
+    size_t   entriesOffset_; // 分片内条目数组相对分片起点的偏移
+
+public:
+    // 以 name 打开共享段，不存在或上一个初始化者中途崩溃时由本进程初始化；已初始化时几何参数必须一致
+    FShmLruCache(const std::string & name, size_t capacity, int sliceNum)
+        : name_(name)
+        , base_(nullptr)
+        , sliceNum_(static_cast<uint32_t>(sliceNum))
+    {
+        if (sliceNum <= 0 || capacity == 0)
+            throw std::invalid_argument("FShmLruCache: capacity and sliceNum must be positive");
+
+        sliceCapacity_ = static_cast<uint32_t>((capacity + sliceNum_ - 1) / sliceNum_);
+        bucketCount_ = 1;
+        while (bucketCount_ < sliceCapacity_ * 2)
+            bucketCount_ <<= 1;
+
+        shardsOffset_ = alignUp(sizeof(ShmHeader));
+        slicesOffset_ = shardsOffset_ + sizeof(ShmShard) * sliceNum_;
+        entriesOffset_ = alignUp(sizeof(uint32_t) * bucketCount_);
+        sliceBytes_ = entriesOffset_ + alignUp(sizeof(ShmEntry) * sliceCapacity_);
+        totalBytes_ = slicesOffset_ + sliceBytes_ * sliceNum_;
+
+        int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name_);
+
+        // 初始化期间持有段上的文件锁：初始化者崩溃时锁随进程释放而 ready 仍为 0，
+        // 下一个加锁的进程据此识别出半成品段并重新初始化，不需要轮询等待
+        if (flock(fd, LOCK_EX) != 0)
+        {
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "flock " + name_);
+        }
+
+        bool initialize;
+        try
+        {
+            initialize = !isInitialized(fd);
+        }
+        catch (...)
+        {
+            close(fd);
+            throw;
+        }
+
+        if (initialize && ftruncate(fd, totalBytes_) != 0)
+        {
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "ftruncate " + name_);
+        }
+
+        void * mapped = mmap(nullptr, totalBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int err = errno;
+        if (mapped == MAP_FAILED)
+        {
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "mmap " + name_);
+        }
+        base_ = static_cast<char *>(mapped);
+
+        if (initialize)
+            initializeSegment();
+        // 映射会持有打开的文件，仅 close 不会释放 flock，须显式解锁
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+
+    ~FShmLruCache() override
+    {
+        if (base_ != nullptr)
+            munmap(base_, totalBytes_);
+    }
+
+    FShmLruCache(const FShmLruCache &) = delete;
+    FShmLruCache & operator=(const FShmLruCache &) = delete;
+
+    // 删除共享段名字，已映射的进程不受影响
+    static void unlink(const std::string & name)
+    {
+        shm_unlink(name.c_str());
+    }
+
+    void put(const Key & key, const Value & value) override
+    {
+        uint64_t hash = mixedHash(key);
+        ShardLock lock(*this, sliceOf(hash));
+        uint32_t slice = sliceOf(hash);
+        ShmShard & shard = shardAt(slice);
+        ShmEntry * entries = entriesAt(slice);
+
+        uint32_t index = findEntry(slice, hash, key);
+        if (index != NIL)
+        {
+            entries[index].value = value;
+            moveToMostRecent(shard, entries, index);
+            return;
+        }
+
+        if (shard.freeHead == NIL)
+            evictLeastRecent(slice);
+
+        index = shard.freeHead;
+        ShmEntry & entry = entries[index];
+        shard.freeHead = entry.next;
+        entry.key = key;
+        entry.value = value;
+        uint32_t & bucket = bucketsAt(slice)[bucketOf(hash)];
+        entry.chainNext = bucket;
+        bucket = index;
+        linkAtTail(shard, entries, index);
+        shard.size++;
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        put(key, static_cast<const Value &>(value));
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        put(static_cast<const Key &>(key), static_cast<const Value &>(value));
+    }
+
+    bool get(const Key & key, Value & value) override
+    {
+        uint64_t hash = mixedHash(key);
+        ShardLock lock(*this, sliceOf(hash));
+        uint32_t slice = sliceOf(hash);
+        uint32_t index = findEntry(slice, hash, key);
+        if (index == NIL)
+            return false;
+
+        ShmEntry * entries = entriesAt(slice);
+        moveToMostRecent(shardAt(slice), entries, index);
+        value = entries[index].value;
+        return true;
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
+    }
+
+    void remove(const Key & key)
+    {
+        uint64_t hash = mixedHash(key);
+        ShardLock lock(*this, sliceOf(hash));
+        uint32_t slice = sliceOf(hash);
+        uint32_t index = findEntry(slice, hash, key);
+        if (index != NIL)
+            releaseEntry(slice, hash, index);
+    }
+
+    // 当前所有分片的条目总数
+    size_t size()
+    {
+        size_t total = 0;
+        for (uint32_t slice = 0; slice < sliceNum_; ++slice)
+        {
+            ShardLock lock(*this, slice);
+            total += shardAt(slice).size;
+        }
+        return total;
+    }
+
+    // 因持锁进程崩溃而被重置的分片次数
+    uint64_t recoveries()
+    {
+        uint64_t total = 0;
+        for (uint32_t slice = 0; slice < sliceNum_; ++slice)
+        {
+            ShardLock lock(*this, slice);
+            total += shardAt(slice).recoveries;
+        }
+        return total;
+    }
+
+    // 逐分片校验 LRU 链表、桶链与空闲链表彼此一致，供测试与排障使用
+    bool verify()
+    {
+        for (uint32_t slice = 0; slice < sliceNum_; ++slice)
+        {
+            ShardLock lock(*this, slice);
+            if (!verifyShard(slice))
+                return false;
+        }
+        return true;
+    }
+
+    // 加锁；上一个持锁进程已崩溃时分片状态不可信，清空后标记锁恢复一致
+    class ShardLock
+    {
+    private:
+        pthread_mutex_t * mutex_;
+    public:
+        ShardLock(FShmLruCache & cache, uint32_t slice)
+            : mutex_(&cache.shardAt(slice).mutex)
+        {
+            int rc = pthread_mutex_lock(mutex_);
+            if (rc == EOWNERDEAD)
+            {
+                cache.resetShard(slice);
+                cache.shardAt(slice).recoveries++;
+                pthread_mutex_consistent(mutex_);
+            }
+            else if (rc != 0)
+            {
+                throw std::system_error(rc, std::generic_category(), "pthread_mutex_lock");
+            }
+        }
+
+        ~ShardLock()
+        {
+            pthread_mutex_unlock(mutex_);
+        }
+
+        ShardLock(const ShardLock &) = delete;
+        ShardLock & operator=(const ShardLock &) = delete;
+    };
+
+    // 持有 key 所在分片的锁直到守卫析构
+    ShardLock lockShardOf(const Key & key)
+    {
+        return ShardLock(*this, sliceOf(mixedHash(key)));
+    }
+
+private:
+
+    static size_t alignUp(size_t bytes)
+    {
+        return (bytes + 63) & ~static_cast<size_t>(63);
+    }
+
+    ShmHeader & header() { return *reinterpret_cast<ShmHeader *>(base_); }
+    ShmShard & shardAt(uint32_t slice) { return reinterpret_cast<ShmShard *>(base_ + shardsOffset_)[slice]; }
+    uint32_t * bucketsAt(uint32_t slice) { return reinterpret_cast<uint32_t *>(base_ + slicesOffset_ + sliceBytes_ * slice); }
+    ShmEntry * entriesAt(uint32_t slice) { return reinterpret_cast<ShmEntry *>(base_ + slicesOffset_ + sliceBytes_ * slice + entriesOffset_); }
+
+    // 同一份程序在各进程中的 std::hash 结果一致，再混洗一次使分片与桶取自不同的位
+    uint64_t mixedHash(const Key & key) const
+    {
+        return static_cast<uint64_t>(FHash<Key>{}(key)) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    uint32_t sliceOf(uint64_t hash) const
+    {
+        return static_cast<uint32_t>((hash >> 32) % sliceNum_);
+    }
+
+    uint32_t bucketOf(uint64_t hash) const
+    {
+        return static_cast<uint32_t>(hash >> 8) & (bucketCount_ - 1);
+    }
+
+    // 持文件锁时调用：段已由某进程完整初始化返回 true，且几何参数须与本进程一致；
+    // 新建的空段或初始化者中途崩溃留下的段（ready 为 0）返回 false
+    bool isInitialized(int fd)
+    {
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+            throw std::system_error(errno, std::generic_category(), "fstat " + name_);
+        if (static_cast<size_t>(st.st_size) < sizeof(ShmHeader))
+            return false;
+
+        void * mapped = mmap(nullptr, sizeof(ShmHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mmap " + name_);
+        const ShmHeader & h = *static_cast<const ShmHeader *>(mapped);
+        bool ready = h.ready.load(std::memory_order_acquire) != 0;
+        bool sameLayout = h.magic == MAGIC && h.layoutVersion == LAYOUT_VERSION
+            && h.sliceNum == sliceNum_ && h.sliceCapacity == sliceCapacity_ && h.bucketCount == bucketCount_
+            && h.entrySize == sizeof(ShmEntry) && h.totalBytes == totalBytes_
+            && static_cast<size_t>(st.st_size) == totalBytes_;
+        std::string layout = "slices=" + std::to_string(h.sliceNum) + " sliceCapacity=" + std::to_string(h.sliceCapacity)
+            + " bytes=" + std::to_string(st.st_size);
+        munmap(mapped, sizeof(ShmHeader));
+
+        if (ready && !sameLayout)
+        {
+            throw std::runtime_error("FShmLruCache: segment " + name_ + " has a different layout (" + layout
+                + "), expected slices=" + std::to_string(sliceNum_) + " sliceCapacity=" + std::to_string(sliceCapacity_)
+                + " bytes=" + std::to_string(totalBytes_));
+        }
+        return ready;
+    }
+
+    void initializeSegment()
+    {
+        ShmHeader & h = header();
+        h.magic = MAGIC;
+        h.layoutVersion = LAYOUT_VERSION;
+        h.sliceNum = sliceNum_;
+        h.sliceCapacity = sliceCapacity_;
+        h.bucketCount = bucketCount_;
+        h.entrySize = sizeof(ShmEntry);
+        h.totalBytes = totalBytes_;
+
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        for (uint32_t slice = 0; slice < sliceNum_; ++slice)
+        {
+            ShmShard & shard = shardAt(slice);
+            pthread_mutex_init(&shard.mutex, &attr);
+            shard.recoveries = 0;
+            resetShard(slice);
+        }
+        pthread_mutexattr_destroy(&attr);
+
+        h.ready.store(1, std::memory_order_release);
+    }
+
+    void resetShard(uint32_t slice)
+    {
+        ShmShard & shard = shardAt(slice);
+        shard.head = NIL;
+        shard.tail = NIL;
+        shard.size = 0;
+
+        uint32_t * buckets = bucketsAt(slice);
+        for (uint32_t i = 0; i < bucketCount_; ++i)
+            buckets[i] = NIL;
+
+        ShmEntry * entries = entriesAt(slice);
+        for (uint32_t i = 0; i < sliceCapacity_; ++i)
+            entries[i].next = (i + 1 < sliceCapacity_) ? i + 1 : NIL;
+        shard.freeHead = 0;
+    }
+
+    bool verifyShard(uint32_t slice)
+    {
+        ShmShard & shard = shardAt(slice);
+        ShmEntry * entries = entriesAt(slice);
+
+        uint32_t count = 0;
+        uint32_t prev = NIL;
+        for (uint32_t index = shard.head; index != NIL; index = entries[index].next)
+        {
+            if (index >= sliceCapacity_ || entries[index].prev != prev || ++count > sliceCapacity_)
+                return false;
+            const Key & key = entries[index].key;
+            if (findEntry(slice, mixedHash(key), key) != index)
+                return false;
+            prev = index;
+        }
+        if (prev != shard.tail || count != shard.size)
+            return false;
+
+        for (uint32_t index = shard.freeHead; index != NIL; index = entries[index].next)
+        {
+            if (index >= sliceCapacity_ || ++count > sliceCapacity_)
+                return false;
+        }
+        return count == sliceCapacity_;
+    }
+
+    uint32_t findEntry(uint32_t slice, uint64_t hash, const Key & key)
+    {
+        ShmEntry * entries = entriesAt(slice);
+        uint32_t index = bucketsAt(slice)[bucketOf(hash)];
+        while (index != NIL && !(entries[index].key == key))
+            index = entries[index].chainNext;
+        return index;
+    }
+
+    void linkAtTail(ShmShard & shard, ShmEntry * entries, uint32_t index)
+    {
+        entries[index].prev = shard.tail;
+        entries[index].next = NIL;
+        if (shard.tail != NIL)
+            entries[shard.tail].next = index;
+        else
+            shard.head = index;
+        shard.tail = index;
+    }
+
+    void unlinkEntry(ShmShard & shard, ShmEntry * entries, uint32_t index)
+    {
+        ShmEntry & entry = entries[index];
+        if (entry.prev != NIL)
+            entries[entry.prev].next = entry.next;
+        else
+            shard.head = entry.next;
+        if (entry.next != NIL)
+            entries[entry.next].prev = entry.prev;
+        else
+            shard.tail = entry.prev;
+    }
+
+    void moveToMostRecent(ShmShard & shard, ShmEntry * entries, uint32_t index)
+    {
+        if (shard.tail == index)
+            return;
+        unlinkEntry(shard, entries, index);
+        linkAtTail(shard, entries, index);
+    }
+
+    void evictLeastRecent(uint32_t slice)
+    {
+        uint32_t victim = shardAt(slice).head;
+        releaseEntry(slice, mixedHash(entriesAt(slice)[victim].key), victim);
+    }
+
+    // 从桶链与 LRU 链表摘除条目并放回空闲链表
+    void releaseEntry(uint32_t slice, uint64_t hash, uint32_t index)
+    {
+        ShmShard & shard = shardAt(slice);
+        ShmEntry * entries = entriesAt(slice);
+
+        uint32_t * link = &bucketsAt(slice)[bucketOf(hash)];
+        while (*link != index)
+            link = &entries[*link].chainNext;
+        *link = entries[index].chainNext;
+
+        unlinkEntry(shard, entries, index);
+        entries[index].next = shard.freeHead;
+        shard.freeHead = index;
+        shard.size--;
+    }
+};
+
+} // namespace FreddyCache
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "FCachePolicy.h"
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace FreddyCache
+{
+
+// 容量在编译期确定的小型 LRU，面向单请求 / 单连接内的记忆化：
+// key 连续存放在对齐数组中，整型 key 用 SSE2 / AVX2 一次比较多个槽位；
+// 最近访问顺序用 Capacity x Capacity 的位矩阵维护，无任何堆分配。
+// 不加锁，只应在单个线程内使用。
+template <typename Key, typename Value, size_t Capacity>
+class FSmallLruCache final : public FCachePolicy<Key, Value>
+{
+    static_assert(Capacity > 0 && Capacity <= 64, "FSmallLruCache capacity must be within 1..64");
+
+private:
+    // 按 32 字节补齐，向量比较无需处理尾部
+    static constexpr size_t KEY_SLOTS = (Capacity * sizeof(Key) + 31) / 32 * 32 / sizeof(Key);
+    static constexpr uint64_t FULL_MASK = Capacity == 64 ? ~0ULL : (1ULL << Capacity) - 1;
+    static constexpr bool SIMD_KEYS = std::is_integral_v<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8);
+
+    alignas(64) Key keys_[KEY_SLOTS];
+    // rows_[i] 第 j 位为 1 表示槽位 i 比槽位 j 更近被访问，全 0 的行即最久未访问
+    uint64_t rows_[Capacity];
+    uint64_t occupied_;
+    Value    values_[Capacity];
+
+public:
+    FSmallLruCache()
+        : keys_{}
+        , rows_{}
+        , occupied_(0)
+    {}
+
+    ~FSmallLruCache() override = default;
+
+    void put(const Key & key, const Value & value) override
+    {
+        putImpl(key, value);
+    }
+
+    void put(const Key & key, Value && value) override
+    {
+        putImpl(key, std::move(value));
+    }
+
+    void put(Key && key, Value && value) override
+    {
+        putImpl(key, std::move(value));
+    }
+
+    bool get(const Key & key, Value & value) override
+    {
+        int slot = findSlot(key);
+        if (slot < 0)
+            return false;
+
+        touch(slot);
+        value = values_[slot];
+        return true;
+    }
+
+    Value get(const Key & key) override
+    {
+        Value value{};
+        get(key, value);
+        return value;
+    }
+
+    // 命中时返回指向缓存内 value 的指针，不拷贝；下一次写操作前有效
+    const Value * find(const Key & key)
+    {
+        int slot = findSlot(key);
+        if (slot < 0)
+            return nullptr;
+
+        touch(slot);
+        return &values_[slot];
+    }
+
+    void remove(const Key & key)
+    {
+        int slot = findSlot(key);
+        if (slot >= 0)
+        {
+            occupied_ &= ~(1ULL << slot);
+            rows_[slot] = 0;
+        }
+    }
+
+    size_t size() const
+    {
+        return std::popcount(occupied_);
+    }
+
+private:
+    template <typename V>
+    void putImpl(const Key & key, V && value)
+    {
+        int slot = findSlot(key);
+        if (slot < 0)
+        {
+            slot = occupied_ != FULL_MASK ? std::countr_zero(~occupied_ & FULL_MASK) : leastRecentSlot();
+            keys_[slot] = key;
+            occupied_ |= 1ULL << slot;
+        }
+        values_[slot] = std::forward<V>(value);
+        touch(slot);
+    }
+
+    void touch(int slot)
+    {
+        uint64_t column = ~(1ULL << slot);
+        for (size_t i = 0; i < Capacity; ++i)
+            rows_[i] &= column;
+        rows_[slot] = FULL_MASK & column;
+    }
+
+    // 满时必有且只有一个全 0 的行
+    int leastRecentSlot() const
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            if (rows_[i] == 0)
+                return static_cast<int>(i);
+        }
+        return 0;
+    }
+
+    int findSlot(const Key & key) const
+    {
+        uint64_t matches;
+        if constexpr (SIMD_KEYS)
+            matches = matchKeys(key);
+        else
+            matches = matchKeysScalar(key);
+
+        matches &= occupied_;
+        return matches ? std::countr_zero(matches) : -1;
+    }
+
+    uint64_t matchKeysScalar(const Key & key) const
+    {
+        uint64_t matches = 0;
+        for (uint64_t bits = occupied_; bits; bits &= bits - 1)
+        {
+            int slot = std::countr_zero(bits);
+            if (keys_[slot] == key)
+                matches |= 1ULL << slot;
+        }
+        return matches;
+    }
+
+    // 返回所有槽位（含未占用槽位）的匹配位图
+    uint64_t matchKeys(const Key & key) const
+    {
+#if defined(__AVX2__)
+        uint64_t matches = 0;
+        const char * base = reinterpret_cast<const char *>(keys_);
+        if constexpr (sizeof(Key) == 4)
+        {
+            __m256i needle = _mm256_set1_epi32(static_cast<int>(key));
+            for (size_t i = 0; i < KEY_SLOTS; i += 8)
+            {
+                __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i *>(base + i * 4));
+                uint32_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+                matches |= static_cast<uint64_t>(mask) << i;
+            }
+        }
+        else
+        {
+            __m256i needle = _mm256_set1_epi64x(static_cast<long long>(key));
+            for (size_t i = 0; i < KEY_SLOTS; i += 4)
+            {
+                __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i *>(base + i * 8));
+                uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(block, needle)));
+                matches |= static_cast<uint64_t>(mask) << i;
+            }
+        }
+        return matches;
+#elif defined(__SSE2__)
+        uint64_t matches = 0;
+        const char * base = reinterpret_cast<const char *>(keys_);
+        if constexpr (sizeof(Key) == 4)
+        {
+            __m128i needle = _mm_set1_epi32(static_cast<int>(key));
+            for (size_t i = 0; i < KEY_SLOTS; i += 4)
+            {
+                __m128i block = _mm_load_si128(reinterpret_cast<const __m128i *>(base + i * 4));
+                uint32_t mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+                matches |= static_cast<uint64_t>(mask) << i;
+            }
+        }
+        else
+        {
+            // SSE2 没有 64 位相等比较：两半都相等才算相等
+            __m128i needle = _mm_set1_epi64x(static_cast<long long>(key));
+            for (size_t i = 0; i < KEY_SLOTS; i += 2)
+            {
+                __m128i block = _mm_load_si128(reinterpret_cast<const __m128i *>(base + i * 8));
+                __m128i eq32 = _mm_cmpeq_epi32(block, needle);
+                __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+                uint32_t mask = _mm_movemask_pd(_mm_castsi128_pd(eq64));
+                matches |= static_cast<uint64_t>(mask) << i;
+            }
+        }
+        return matches;
+#else
+        uint64_t matches = 0;
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            if (keys_[i] == key)
+                matches |= 1ULL << i;
+        }
+        return matches;
+#endif
+    }
+};
+
+} // namespace FreddyCache
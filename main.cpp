@@ -1,11 +1,81 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "tests/report.h"
+
 void testHotDataAccess();
 void testLoopPattern();
-void testWorkloadShift();
+void testWorkloadShift(const std::string & timelineCsvPath);
+void testSharedMemory();
+void testRemovalListener();
+void testHashLruCache();
+void testSmallLruCache();
+void testValueHandle();
+void testHeterogeneousLookup();
 
-int main()
+// ./main [--repeat 次数] [--json 结果.json] [--csv 结果.csv] [--timeline 负载剧变逐窗口.csv]
+// ./main --compare 基准.json 当前.json [阈值百分比]
+int main(int argc, char * argv[])
 {
-    testHotDataAccess();
-    testLoopPattern();
-    testWorkloadShift();
+    std::string jsonPath;
+    std::string csvPath;
+    std::string timelinePath;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--compare" && i + 2 < argc)
+        {
+            double threshold = i + 3 < argc ? std::atof(argv[i + 3]) : 5.0;
+            int regressions = compareResults(argv[i + 1], argv[i + 2], threshold);
+            return regressions == 0 ? 0 : 1;
+        }
+        else if (arg == "--json" && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (arg == "--csv" && i + 1 < argc)
+        {
+            csvPath = argv[++i];
+        }
+        else if (arg == "--repeat" && i + 1 < argc)
+        {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--timeline" && i + 1 < argc)
+        {
+            timelinePath = argv[++i];
+        }
+        else
+        {
+            std::cout << "用法: " << argv[0] << " [--repeat 次数] [--json 文件] [--csv 文件] [--timeline 文件]" << std::endl
+                      << "      " << argv[0] << " --compare 基准.json 当前.json [阈值百分比]" << std::endl;
+            return 2;
+        }
+    }
+
+    // 重复运行性能场景，--compare 以各次重复的吞吐判断退化；逐窗口时间线只写第一次
+    for (int r = 0; r < repeat; ++r)
+    {
+        if (repeat > 1)
+            std::cout << "\n##### 第 " << r + 1 << "/" << repeat << " 次重复 #####" << std::endl;
+        testHotDataAccess();
+        testLoopPattern();
+        testWorkloadShift(r == 0 ? timelinePath : std::string());
+        testSharedMemory();
+    }
+    testRemovalListener();
+    testHashLruCache();
+    testSmallLruCache();
+    testValueHandle();
+    testHeterogeneousLookup();
+
+    MachineInfo machine = collectMachineInfo();
+    if (!jsonPath.empty() && !writeResultsJson(jsonPath, collectedResults(), machine))
+        std::cout << "写出 JSON 失败: " << jsonPath << std::endl;
+    if (!csvPath.empty() && !writeResultsCsv(csvPath, collectedResults(), machine))
+        std::cout << "写出 CSV 失败: " << csvPath << std::endl;
     return 0;
-}
\ No newline at end of file
+}
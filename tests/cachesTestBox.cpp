@@ -1,28 +1,87 @@
 #include "cachesTestBox.h"
 #include "FLruCache.h"
 #include "FLfuCache.h"
+#include "FGdsfCache.h"
 
-CachesTestBox initCachesTestBox(int capacity, int k, int threshold, int granularity)
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+
+std::vector<std::unique_ptr<FreddyCache::FCachePolicy<int, std::string>>> makeCaches(int capacity, int k, int threshold, int granularity)
 {
     auto lru = std::make_unique<FreddyCache::FLruCache<int, std::string>>(capacity);
     auto lruk = std::make_unique<FreddyCache::FLruKCache<int, std::string>>(capacity, capacity, k);
     auto lfu = std::make_unique<FreddyCache::FLfuCache<int, std::string>>(capacity, threshold, granularity);
+    auto slru = std::make_unique<FreddyCache::FSlruCache<int, std::string>>(capacity);
+    auto gdsf = std::make_unique<FreddyCache::FGdsfCache<int, std::string>>(capacity);
+
+    std::vector<std::unique_ptr<FreddyCache::FCachePolicy<int, std::string>>> caches;
+    caches.emplace_back(std::move(lru));
+    caches.emplace_back(std::move(lruk));
+    caches.emplace_back(std::move(lfu));
+    caches.emplace_back(std::move(slru));
+    caches.emplace_back(std::move(gdsf));
+    return caches;
+}
+
+size_t heapInUse()
+{
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
 
+// 在另一组同参数的缓存上逐个装满，以堆占用增量估算每个条目的内存开销
+std::vector<double> measureBytesPerEntry(int capacity, int k, int threshold, int granularity)
+{
+    auto caches = makeCaches(capacity, k, threshold, granularity);
+    std::vector<double> bytes(caches.size(), 0);
+    if (capacity <= 0 || heapInUse() == 0)
+        return bytes;
+
+    for (size_t i = 0; i < caches.size(); ++i)
+    {
+        size_t before = heapInUse();
+        for (int key = 0; key < capacity; ++key)
+        {
+            // 重复写入 k 次，使 LRU-K 的条目也进入主缓存
+            for (int n = 0; n < k; ++n)
+                caches[i]->put(key, "value" + std::to_string(key));
+        }
+        size_t after = heapInUse();
+        bytes[i] = after > before ? static_cast<double>(after - before) / capacity : 0;
+    }
+    return bytes;
+}
+
+}
+
+CachesTestBox initCachesTestBox(int capacity, int k, int threshold, int granularity)
+{
     CachesTestBox c;
-    c.caches.clear(),
-    c.caches.emplace_back(std::move(lru));
-    c.caches.emplace_back(std::move(lruk));
-    c.caches.emplace_back(std::move(lfu));
+    c.caches = makeCaches(capacity, k, threshold, granularity);
 
     auto cacheNums = c.caches.size();
     c.hit_counts = std::vector<int>(cacheNums, 0);
     c.get_counts = std::vector<int>(cacheNums, 0);
+    c.hit_costs = std::vector<double>(cacheNums, 0);
+    c.get_costs = std::vector<double>(cacheNums, 0);
     c.cache_names = {
         "LRU",
         "LRU-K" + std::to_string(k),
-        "LFU"
+        "LFU",
+        "SLRU",
+        "GDSF"
     };
+    c.cost_aware = { false, false, false, false, true };
     c.average_operation_time = std::vector<double>(cacheNums, 0);
+    c.latency_samplers = std::vector<LatencySampler>(cacheNums);
+    c.bytes_per_entry = measureBytesPerEntry(capacity, k, threshold, granularity);
 
     return c;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "FCachePolicy.h"
+#include "testUtils.h"
 
 struct CachesTestBox
 {
@@ -12,8 +13,13 @@ struct CachesTestBox
     std::vector<std::unique_ptr<FreddyCache::FCachePolicy<int, std::string>>> caches;
     std::vector<int> hit_counts;
     std::vector<int> get_counts;
+    std::vector<double> hit_costs;  // 命中所节省的回源代价
+    std::vector<double> get_costs;  // 全部读取的回源代价
     std::vector<std::string> cache_names;
+    std::vector<bool> cost_aware;   // 是否按回源代价淘汰
     std::vector<double> average_operation_time;
+    std::vector<LatencySampler> latency_samplers;
+    std::vector<double> bytes_per_entry;  // 装满后每个条目占用的堆内存，无法统计时为 0
 };
 
 CachesTestBox initCachesTestBox(int capacity, int k, int threshold, int granularity);
\ No newline at end of file
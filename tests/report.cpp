@@ -0,0 +1,665 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include "report.h"
+
+namespace
+{
+
+// 判定命中率变化显著性的临界值，约对应双侧 p < 0.003
+const double SIGNIFICANCE_Z = 3.0;
+
+// 吞吐受机器噪声影响，同一程序两次运行即可相差 10% 以上，单次运行内的逐次时延样本
+// 反映不了这种波动；只有两侧都至少有这么多次重复时才按各次吞吐做 t 检验并参与判定
+const size_t MIN_REPETITIONS = 3;
+
+// Welch t 检验双侧 p < 0.01 的临界值，按自由度向下取表项，偏保守
+double tCritical(double df)
+{
+    static const std::pair<double, double> table[] = {
+        { 1, 63.657 }, { 2, 9.925 }, { 3, 5.841 }, { 4, 4.604 }, { 5, 4.032 }, { 6, 3.707 },
+        { 7, 3.499 }, { 8, 3.355 }, { 9, 3.250 }, { 10, 3.169 }, { 12, 3.055 }, { 15, 2.947 },
+        { 20, 2.845 }, { 30, 2.750 }, { 60, 2.660 }, { 120, 2.617 }
+    };
+    double critical = table[0].second;
+    for (const auto & entry : table)
+    {
+        if (df >= entry.first)
+            critical = entry.second;
+    }
+    return df >= 1000 ? 2.576 : critical;
+}
+
+// 可缺失的指标以 NaN 表示，写出时替换为 absent（JSON 中为 null，CSV 中留空）
+struct OptionalNumber
+{
+    double value;
+    const char * absent;
+};
+
+std::ostream & operator<<(std::ostream & out, const OptionalNumber & n)
+{
+    return std::isnan(n.value) ? out << n.absent : out << n.value;
+}
+
+std::string jsonEscape(const std::string & s)
+{
+    std::string out;
+    for (unsigned char c : s)
+    {
+        switch (c)
+        {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (c < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            }
+            else
+            {
+                out += static_cast<char>(c);
+            }
+        }
+    }
+    return out;
+}
+
+std::string csvQuote(const std::string & s)
+{
+    std::string out = "\"";
+    for (char c : s)
+    {
+        if (c == '"')
+            out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string readCpuModel()
+{
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos)
+            {
+                size_t begin = line.find_first_not_of(" \t", colon + 1);
+                return begin == std::string::npos ? "" : line.substr(begin);
+            }
+        }
+    }
+    return "unknown";
+}
+
+// 只解析本文件写出的 JSON 结构所需的子集：对象、数组、字符串、数值与字面量
+struct JsonValue
+{
+    enum Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Null;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    const JsonValue * find(const std::string & key) const
+    {
+        for (const auto & member : object)
+        {
+            if (member.first == key)
+                return &member.second;
+        }
+        return nullptr;
+    }
+
+    bool hasNumber(const std::string & key) const
+    {
+        const JsonValue * v = find(key);
+        return v && v->type == Number;
+    }
+
+    double numberAt(const std::string & key) const
+    {
+        const JsonValue * v = find(key);
+        return v && v->type == Number ? v->number : 0;
+    }
+
+    std::string stringAt(const std::string & key) const
+    {
+        const JsonValue * v = find(key);
+        return v && v->type == String ? v->string : "";
+    }
+};
+
+class JsonParser
+{
+private:
+    const std::string & text_;
+    size_t pos_;
+public:
+    explicit JsonParser(const std::string & text)
+        : text_(text)
+        , pos_(0)
+    {}
+
+    bool parse(JsonValue & value)
+    {
+        if (!parseValue(value))
+            return false;
+        skipSpace();
+        return pos_ == text_.size();
+    }
+
+private:
+    void skipSpace()
+    {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])))
+            pos_++;
+    }
+
+    bool consume(char c)
+    {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c)
+        {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseValue(JsonValue & value)
+    {
+        skipSpace();
+        if (pos_ >= text_.size())
+            return false;
+
+        char c = text_[pos_];
+        if (c == '{')
+            return parseObject(value);
+        if (c == '[')
+            return parseArray(value);
+        if (c == '"')
+        {
+            value.type = JsonValue::String;
+            return parseString(value.string);
+        }
+        if (text_.compare(pos_, 4, "true") == 0 || text_.compare(pos_, 5, "false") == 0)
+        {
+            value.type = JsonValue::Bool;
+            value.number = text_[pos_] == 't';
+            pos_ += text_[pos_] == 't' ? 4 : 5;
+            return true;
+        }
+        if (text_.compare(pos_, 4, "null") == 0)
+        {
+            value.type = JsonValue::Null;
+            pos_ += 4;
+            return true;
+        }
+
+        const char * begin = text_.c_str() + pos_;
+        char * end = nullptr;
+        value.type = JsonValue::Number;
+        value.number = std::strtod(begin, &end);
+        if (end == begin)
+            return false;
+        pos_ += end - begin;
+        return true;
+    }
+
+    bool parseString(std::string & out)
+    {
+        if (!consume('"'))
+            return false;
+        while (pos_ < text_.size())
+        {
+            char c = text_[pos_++];
+            if (c == '"')
+                return true;
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if (pos_ >= text_.size())
+                return false;
+            char e = text_[pos_++];
+            switch (e)
+            {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u':
+            {
+                // 写出端只会转义控制字符，按单字节还原；非法的转义按格式错误处理
+                if (pos_ + 4 > text_.size())
+                    return false;
+                int code = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    char h = text_[pos_ + i];
+                    if (!std::isxdigit(static_cast<unsigned char>(h)))
+                        return false;
+                    code = code * 16 + (std::isdigit(static_cast<unsigned char>(h)) ? h - '0' : std::tolower(h) - 'a' + 10);
+                }
+                out += static_cast<char>(code);
+                pos_ += 4;
+                break;
+            }
+            default: out += e; break;
+            }
+        }
+        return false;
+    }
+
+    bool parseArray(JsonValue & value)
+    {
+        value.type = JsonValue::Array;
+        consume('[');
+        if (consume(']'))
+            return true;
+        do
+        {
+            value.array.emplace_back();
+            if (!parseValue(value.array.back()))
+                return false;
+        } while (consume(','));
+        return consume(']');
+    }
+
+    bool parseObject(JsonValue & value)
+    {
+        value.type = JsonValue::Object;
+        consume('{');
+        if (consume('}'))
+            return true;
+        do
+        {
+            std::string key;
+            skipSpace();
+            if (!parseString(key) || !consume(':'))
+                return false;
+            value.object.emplace_back(std::move(key), JsonValue());
+            if (!parseValue(value.object.back().second))
+                return false;
+        } while (consume(','));
+        return consume('}');
+    }
+};
+
+bool loadResultsJson(const std::string & path, JsonValue & root)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cout << "无法读取结果文件: " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+    if (!JsonParser(text).parse(root) || !root.find("results"))
+    {
+        std::cout << "结果文件格式错误: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+double relativeChange(double base, double current)
+{
+    return base != 0 ? 100.0 * (current - base) / base : 0;
+}
+
+// 同一 (场景, 策略) 的各次重复，按首次出现的顺序排列
+using ResultGroups = std::vector<std::pair<std::string, std::vector<const JsonValue *>>>;
+
+ResultGroups groupResults(const JsonValue & root)
+{
+    ResultGroups groups;
+    for (const auto & r : root.find("results")->array)
+    {
+        std::string key = r.stringAt("scenario") + " / " + r.stringAt("policy");
+        auto it = std::find_if(groups.begin(), groups.end(), [&](const auto & g) { return g.first == key; });
+        if (it == groups.end())
+            it = groups.insert(groups.end(), { key, {} });
+        it->second.push_back(&r);
+    }
+    return groups;
+}
+
+const std::vector<const JsonValue *> * findGroup(const ResultGroups & groups, const std::string & key)
+{
+    for (const auto & g : groups)
+    {
+        if (g.first == key)
+            return &g.second;
+    }
+    return nullptr;
+}
+
+struct Summary
+{
+    double mean;
+    double variance;
+    size_t n;
+};
+
+Summary summarize(const std::vector<const JsonValue *> & runs, const std::string & field)
+{
+    Summary s{0, 0, runs.size()};
+    for (const auto * r : runs)
+        s.mean += r->numberAt(field);
+    s.mean /= s.n;
+    for (const auto * r : runs)
+        s.variance += (r->numberAt(field) - s.mean) * (r->numberAt(field) - s.mean);
+    s.variance = s.n > 1 ? s.variance / (s.n - 1) : 0;
+    return s;
+}
+
+}
+
+MachineInfo collectMachineInfo()
+{
+    MachineInfo info;
+
+    char host[256] = {0};
+    info.hostname = gethostname(host, sizeof(host) - 1) == 0 ? host : "unknown";
+    info.cpu = readCpuModel();
+    info.cores = std::thread::hardware_concurrency();
+
+    struct utsname name;
+    info.os = uname(&name) == 0
+        ? std::string(name.sysname) + " " + name.release + " " + name.machine
+        : "unknown";
+
+#if defined(__clang__)
+    info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    info.compiler = "gcc " __VERSION__;
+#else
+    info.compiler = "unknown";
+#endif
+
+#if defined(NDEBUG)
+    info.build = "release";
+#else
+    info.build = "debug";
+#endif
+#if defined(__AVX2__)
+    info.build += " avx2";
+#endif
+    return info;
+}
+
+std::vector<PolicyResult> & collectedResults()
+{
+    static std::vector<PolicyResult> results;
+    return results;
+}
+
+void recordResults(
+    const std::string & testName,
+    const ScenarioParameters & parameters,
+    const CachesTestBox & ctb,
+    const Workload & workload
+)
+{
+    for (size_t i = 0; i < ctb.caches.size(); ++i)
+    {
+        const LatencySampler & sampler = ctb.latency_samplers[i];
+
+        PolicyResult r;
+        r.scenario = testName;
+        r.policy = ctb.cache_names[i];
+        r.repetition = 0;
+        r.parameters = parameters;
+        r.seed = workload.seed;
+        r.operations = workload.ops.size();
+        r.gets = ctb.get_counts[i];
+        r.hits = ctb.hit_counts[i];
+        r.hitRate = r.gets > 0 ? static_cast<double>(r.hits) / r.gets : 0;
+        r.costWeightedHitRate = ctb.get_costs[i] > 0 ? ctb.hit_costs[i] / ctb.get_costs[i] : 0;
+        r.opsPerSecond = ctb.average_operation_time[i] > 0 ? 1e6 / ctb.average_operation_time[i] : 0;
+        r.bytesPerEntry = ctb.bytes_per_entry[i];
+        r.latencySamples = sampler.count();
+        r.latencyMean = sampler.mean();
+        r.latencyStddev = sampler.stddev();
+        r.latencyP50 = sampler.percentile(0.50);
+        r.latencyP90 = sampler.percentile(0.90);
+        r.latencyP99 = sampler.percentile(0.99);
+        r.latencyP999 = sampler.percentile(0.999);
+        recordResult(std::move(r));
+    }
+}
+
+void recordResult(PolicyResult result)
+{
+    auto & results = collectedResults();
+    result.repetition = static_cast<int>(std::count_if(results.begin(), results.end(), [&](const PolicyResult & r) {
+        return r.scenario == result.scenario && r.policy == result.policy;
+    }));
+    results.push_back(std::move(result));
+}
+
+bool writeResultsJson(const std::string & path, const std::vector<PolicyResult> & results, const MachineInfo & machine)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << std::setprecision(10);
+    out << "{\n"
+        << "  \"machine\": {"
+        << "\"hostname\": \"" << jsonEscape(machine.hostname) << "\", "
+        << "\"cpu\": \"" << jsonEscape(machine.cpu) << "\", "
+        << "\"cores\": " << machine.cores << ", "
+        << "\"os\": \"" << jsonEscape(machine.os) << "\", "
+        << "\"compiler\": \"" << jsonEscape(machine.compiler) << "\", "
+        << "\"build\": \"" << jsonEscape(machine.build) << "\"},\n"
+        << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto & r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"scenario\": \"" << jsonEscape(r.scenario) << "\", "
+            << "\"policy\": \"" << jsonEscape(r.policy) << "\", "
+            << "\"repetition\": " << r.repetition << ", "
+            << "\"parameters\": {";
+        for (size_t p = 0; p < r.parameters.size(); ++p)
+        {
+            out << (p == 0 ? "" : ", ") << "\"" << jsonEscape(r.parameters[p].first) << "\": " << r.parameters[p].second;
+        }
+        out << "}, "
+            << "\"seed\": " << r.seed << ", "
+            << "\"operations\": " << r.operations << ", "
+            << "\"gets\": " << r.gets << ", "
+            << "\"hits\": " << r.hits << ", "
+            << "\"hit_rate\": " << r.hitRate << ", "
+            << "\"cost_weighted_hit_rate\": " << OptionalNumber{ r.costWeightedHitRate, "null" } << ", "
+            << "\"ops_per_second\": " << r.opsPerSecond << ", "
+            << "\"bytes_per_entry\": " << r.bytesPerEntry << ", "
+            << "\"latency_us\": {"
+            << "\"samples\": " << r.latencySamples << ", "
+            << "\"mean\": " << r.latencyMean << ", "
+            << "\"stddev\": " << r.latencyStddev << ", "
+            << "\"p50\": " << r.latencyP50 << ", "
+            << "\"p90\": " << r.latencyP90 << ", "
+            << "\"p99\": " << r.latencyP99 << ", "
+            << "\"p999\": " << r.latencyP999 << "}}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool writeResultsCsv(const std::string & path, const std::vector<PolicyResult> & results, const MachineInfo & machine)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << std::setprecision(10);
+    out << "scenario,policy,repetition,parameters,seed,operations,gets,hits,hit_rate,cost_weighted_hit_rate,ops_per_second,"
+        << "bytes_per_entry,latency_samples,latency_mean_us,latency_stddev_us,p50_us,p90_us,p99_us,p999_us,"
+        << "hostname,cpu,cores,os,compiler,build\n";
+    for (const auto & r : results)
+    {
+        std::string parameters;
+        for (const auto & p : r.parameters)
+        {
+            std::ostringstream item;
+            item << p.first << '=' << p.second;
+            parameters += (parameters.empty() ? "" : ";") + item.str();
+        }
+        out << csvQuote(r.scenario) << ','
+            << csvQuote(r.policy) << ','
+            << r.repetition << ','
+            << csvQuote(parameters) << ','
+            << r.seed << ','
+            << r.operations << ','
+            << r.gets << ','
+            << r.hits << ','
+            << r.hitRate << ','
+            << OptionalNumber{ r.costWeightedHitRate, "" } << ','
+            << r.opsPerSecond << ','
+            << r.bytesPerEntry << ','
+            << r.latencySamples << ','
+            << r.latencyMean << ','
+            << r.latencyStddev << ','
+            << r.latencyP50 << ','
+            << r.latencyP90 << ','
+            << r.latencyP99 << ','
+            << r.latencyP999 << ','
+            << csvQuote(machine.hostname) << ','
+            << csvQuote(machine.cpu) << ','
+            << machine.cores << ','
+            << csvQuote(machine.os) << ','
+            << csvQuote(machine.compiler) << ','
+            << csvQuote(machine.build) << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+int compareResults(const std::string & basePath, const std::string & currentPath, double thresholdPercent)
+{
+    JsonValue base, current;
+    if (!loadResultsJson(basePath, base) || !loadResultsJson(currentPath, current))
+        return -1;
+
+    std::cout << "=== 结果对比: " << basePath << " -> " << currentPath << " ===" << std::endl;
+    const JsonValue * baseMachine = base.find("machine");
+    const JsonValue * currentMachine = current.find("machine");
+    if (baseMachine && currentMachine && baseMachine->stringAt("cpu") != currentMachine->stringAt("cpu"))
+        std::cout << "注意: 两次运行的 CPU 不同，吞吐对比仅供参考" << std::endl;
+
+    ResultGroups baseGroups = groupResults(base);
+    ResultGroups currentGroups = groupResults(current);
+
+    int regressions = 0;
+    int missing = 0;
+    for (const auto & [key, baseRuns] : baseGroups)
+    {
+        if (!findGroup(currentGroups, key))
+        {
+            std::cout << key << "\t- 当前结果中缺失 [缺失]" << std::endl;
+            missing++;
+        }
+    }
+
+    for (const auto & [key, currentRuns] : currentGroups)
+    {
+        const auto * baseRuns = findGroup(baseGroups, key);
+        if (!baseRuns)
+        {
+            std::cout << key << "\t- 基准中不存在，跳过" << std::endl;
+            continue;
+        }
+        const JsonValue & b = *baseRuns->front();
+        const JsonValue & c = *currentRuns.front();
+        if (b.numberAt("seed") != c.numberAt("seed"))
+            std::cout << key << "\t- 注意: 两次运行的种子不同" << std::endl;
+
+        // 吞吐：各次重复的 ops/s 做 Welch t 检验，重复不足时只展示变化
+        Summary bt = summarize(*baseRuns, "ops_per_second");
+        Summary ct = summarize(currentRuns, "ops_per_second");
+        double throughputChange = relativeChange(bt.mean, ct.mean);
+        bool enoughRuns = bt.n >= MIN_REPETITIONS && ct.n >= MIN_REPETITIONS;
+        double throughputT = 0;
+        double throughputCritical = 0;
+        if (enoughRuns)
+        {
+            double vb = bt.variance / bt.n, vc = ct.variance / ct.n;
+            double se = std::sqrt(vb + vc);
+            double df = se > 0 ? (vb + vc) * (vb + vc) / (vb * vb / (bt.n - 1) + vc * vc / (ct.n - 1)) : 1e9;
+            throughputT = se > 0 ? (ct.mean - bt.mean) / se : (ct.mean < bt.mean ? -1e9 : 0);
+            throughputCritical = tCritical(df);
+        }
+        bool throughputRegressed = enoughRuns && throughputChange < -thresholdPercent && throughputT < -throughputCritical;
+
+        // 命中率：同一种子下各次重复结果一致，取首次运行做两比例 z 检验
+        double g1 = b.numberAt("gets"), h1 = b.numberAt("hits");
+        double g2 = c.numberAt("gets"), h2 = c.numberAt("hits");
+        double hitRateChange = relativeChange(b.numberAt("hit_rate"), c.numberAt("hit_rate"));
+        double hitZ = 0;
+        if (g1 > 0 && g2 > 0)
+        {
+            double pooled = (h1 + h2) / (g1 + g2);
+            double se = std::sqrt(pooled * (1 - pooled) * (1 / g1 + 1 / g2));
+            if (se > 0)
+                hitZ = (h2 / g2 - h1 / g1) / se;
+        }
+        bool hitRateRegressed = hitRateChange < -thresholdPercent && hitZ < -SIGNIFICANCE_Z;
+
+        std::cout   << key
+                    << "\t- 吞吐: "
+                    << std::fixed << std::setprecision(0) << bt.mean << " -> " << ct.mean
+                    << " ops/s (" << std::showpos << std::setprecision(2) << throughputChange << "%" << std::noshowpos;
+        if (enoughRuns)
+            std::cout << ", t=" << std::setprecision(2) << throughputT;
+        else
+            std::cout << ", 重复 " << bt.n << "/" << ct.n << " 次，不参与判定";
+        std::cout   << ")"
+                    << "\t- 命中率: "
+                    << std::setprecision(2) << 100 * b.numberAt("hit_rate") << "% -> " << 100 * c.numberAt("hit_rate") << "%"
+                    << " (z=" << std::setprecision(2) << hitZ << ")";
+        // 加权命中率只在两侧都有记录时展示，缺失（null）的场景跳过
+        if (b.hasNumber("cost_weighted_hit_rate") && c.hasNumber("cost_weighted_hit_rate"))
+            std::cout << "\t- 加权命中率: " << 100 * b.numberAt("cost_weighted_hit_rate") << "% -> "
+                      << 100 * c.numberAt("cost_weighted_hit_rate") << "%";
+        std::cout
+                    << (throughputRegressed ? "\t[吞吐退化]" : "")
+                    << (hitRateRegressed ? "\t[命中率退化]" : "")
+                    << std::endl;
+        regressions += throughputRegressed + hitRateRegressed;
+    }
+
+    std::cout << "显著退化项: " << regressions << "（阈值 " << thresholdPercent << "%，吞吐需两侧各至少 "
+              << MIN_REPETITIONS << " 次重复且 t 检验 p < 0.01，命中率 |z| > " << SIGNIFICANCE_Z << "）";
+    if (missing > 0)
+        std::cout << "\t缺失项: " << missing;
+    std::cout << std::endl;
+    return regressions + missing;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cachesTestBox.h"
+#include "workload.h"
+
+// 结构化结果：各场景把每个策略的结果登记到进程内的报告中，
+// main 结束时按命令行参数写出 JSON / CSV，并可对比两次运行的 JSON 结果
+
+using ScenarioParameters = std::vector<std::pair<std::string, double>>;
+
+struct PolicyResult
+{
+    std::string scenario;
+    std::string policy;
+    int      repetition; // 同一 (场景, 策略) 的第几次重复，从 0 开始
+    ScenarioParameters parameters;
+    uint64_t seed;
+    size_t   operations;
+    int      gets;
+    int      hits;
+    double   hitRate;
+    double   costWeightedHitRate; // 场景未模拟回源代价时为 NaN，写出为缺失
+    double   opsPerSecond;
+    double   bytesPerEntry;
+    // 抽样得到的单次操作时延（μs）
+    size_t   latencySamples;
+    double   latencyMean;
+    double   latencyStddev;
+    double   latencyP50;
+    double   latencyP90;
+    double   latencyP99;
+    double   latencyP999;
+};
+
+struct MachineInfo
+{
+    std::string hostname;
+    std::string cpu;
+    unsigned    cores;
+    std::string os;
+    std::string compiler;
+    std::string build;
+};
+
+MachineInfo collectMachineInfo();
+
+// 进程内已登记的全部结果
+std::vector<PolicyResult> & collectedResults();
+
+// 把一个场景内各策略的结果登记到报告
+void recordResults(
+    const std::string & testName,
+    const ScenarioParameters & parameters,
+    const CachesTestBox & ctb,
+    const Workload & workload
+);
+
+// 登记不经过 CachesTestBox 的单条结果，repetition 由报告按已登记的同名结果自动编号
+void recordResult(PolicyResult result);
+
+bool writeResultsJson(const std::string & path, const std::vector<PolicyResult> & results, const MachineInfo & machine);
+bool writeResultsCsv(const std::string & path, const std::vector<PolicyResult> & results, const MachineInfo & machine);
+
+// 对比两份 JSON 结果，打印每个 (场景, 策略) 的变化，返回显著退化项与基准中有而当前缺失的项数之和，
+// 读取失败时返回 -1。吞吐以各次重复的 ops/s 做 Welch t 检验，两侧重复不足 3 次时只展示不判定；
+// 命中率以两比例 z 检验判断；只有统计显著且相对变化超过 thresholdPercent 时才记为退化
+int compareResults(const std::string & basePath, const std::string & currentPath, double thresholdPercent = 5.0);
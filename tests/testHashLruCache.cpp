@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FLruCache.h"
+
+namespace
+{
+
+bool report(const std::string & name, bool passed)
+{
+    std::cout << name << ": " << (passed ? "通过" : "失败") << std::endl;
+    return passed;
+}
+
+// 让读线程与主线程按步骤交替执行
+class StepGate
+{
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    int step_ = 0;
+public:
+    void advanceTo(int step)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            step_ = step;
+        }
+        changed_.notify_all();
+    }
+
+    void waitFor(int step)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [&] { return step_ >= step; });
+    }
+};
+
+// 一个线程的近端副本在另一个线程 put / remove 同一 key 后失效，读到的是共享层的新状态
+bool checkNearInvalidation()
+{
+    FreddyCache::FHashLruCache<int, std::string> cache(64, 4, 16);
+    cache.put(7, "old");
+
+    StepGate gate;
+    bool nearHit = false;
+    std::string afterPut;
+    bool foundAfterRemove = true;
+    std::thread reader([&] {
+        std::string value;
+        cache.get(7, value);
+        cache.get(7, value); // 第二次应在近端命中
+        nearHit = cache.getNearCacheStats().nearHits == 1 && value == "old";
+        gate.advanceTo(1);
+
+        gate.waitFor(2);
+        cache.get(7, afterPut);
+        gate.advanceTo(3);
+
+        gate.waitFor(4);
+        foundAfterRemove = cache.get(7, value);
+    });
+
+    gate.waitFor(1);
+    cache.put(7, "new");
+    gate.advanceTo(2);
+    gate.waitFor(3);
+    cache.remove(7);
+    gate.advanceTo(4);
+    reader.join();
+
+    return report("近端副本跨线程失效", nearHit && afterPut == "new" && !foundAfterRemove);
+}
+
+// 大量短命线程访问同一实例：线程退出后其近端表被摘除，命中计数仍计入统计
+bool checkThreadChurn()
+{
+    const int THREADS = 500;
+    const int GETS = 10;
+
+    FreddyCache::FHashLruCache<int, int> cache(64, 4, 16);
+    cache.put(1, 1);
+    for (int t = 0; t < THREADS; ++t)
+    {
+        std::thread([&] {
+            int value;
+            for (int i = 0; i < GETS; ++i)
+                cache.get(1, value);
+        }).join();
+    }
+
+    auto stats = cache.getNearCacheStats();
+    std::cout << "\t" << THREADS << " 个线程退出后存活近端表: " << stats.liveTables << std::endl;
+    return report("线程退出释放近端表", stats.liveTables == 0
+        && stats.nearHits + stats.sharedHits == static_cast<size_t>(THREADS * GETS)
+        && stats.sharedHits == static_cast<size_t>(THREADS));
+}
+
+// 自适应分片容量：std::hash<int> 为恒等映射，key = i * SLICES 全部落在 0 号分片。
+// 每轮让 0 号分片的工作集比其当前容量多出一截，被淘汰的 key 很快再被读到（幽灵命中），
+// 容量应持续流向 0 号分片，总和不变，出借方不低于 base / 64
+bool checkRebalance()
+{
+    const int SLICES = 8;
+    const int CAPACITY = 1024;
+    const size_t BASE = CAPACITY / SLICES;
+    const size_t MIN_CAPACITY = std::max<size_t>(1, BASE / 64);
+    const size_t QUANTUM = std::max<size_t>(1, BASE / 16);
+    const int ROUNDS = 150;
+    const int OPS_PER_ROUND = 8192; // 0 号分片每 4096 次操作尝试一次再平衡
+
+    FreddyCache::FHashLruCache<int, int> cache(CAPACITY, SLICES, 0, true);
+    bool conserved = true;
+    bool aboveFloor = true;
+    bool monotonic = true;
+    size_t hotCapacity = BASE;
+    int value;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        int workingSet = static_cast<int>(hotCapacity) + 64;
+        for (int op = 0; op < OPS_PER_ROUND; ++op)
+        {
+            int key = (op % workingSet) * SLICES;
+            if (!cache.get(key, value))
+                cache.put(key, key);
+        }
+
+        auto capacities = cache.getSliceCapacities();
+        conserved = conserved && std::accumulate(capacities.begin(), capacities.end(), size_t(0)) == BASE * SLICES;
+        aboveFloor = aboveFloor && *std::min_element(capacities.begin(), capacities.end()) >= MIN_CAPACITY;
+        monotonic = monotonic && capacities[0] >= hotCapacity;
+        hotCapacity = capacities[0];
+    }
+
+    // 其余分片都应已借到无法再出借一份为止
+    auto capacities = cache.getSliceCapacities();
+    bool drained = std::all_of(capacities.begin() + 1, capacities.end(), [&](size_t c) { return c < MIN_CAPACITY + QUANTUM; });
+    std::cout << "\t0 号分片容量: " << BASE << " -> " << capacities[0] << "\t其余分片: " << capacities[1] << std::endl;
+    return report("分片容量再平衡", conserved && aboveFloor && monotonic && drained);
+}
+
+}
+
+void testHashLruCache()
+{
+    std::cout << "\n=== 测试场景: Hash-LRU 近端缓存与分片测试 ===" << std::endl;
+
+    checkNearInvalidation();
+    checkThreadChurn();
+    checkRebalance();
+}
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "FLruCache.h"
+#include "FLfuCache.h"
+#include "FGdsfCache.h"
+
+namespace
+{
+
+// 记录构造次数的字符串 key：以 string_view 查找与删除时不应构造任何 key
+struct TrackedKey
+{
+    static inline size_t constructions = 0;
+
+    std::string text;
+
+    TrackedKey() = default; // 链表哨兵节点与近端表槽位使用，不在查找路径上
+
+    explicit TrackedKey(std::string_view s)
+        : text(s)
+    {
+        constructions++;
+    }
+
+    TrackedKey(const TrackedKey & other)
+        : text(other.text)
+    {
+        constructions++;
+    }
+
+    TrackedKey(TrackedKey && other) noexcept
+        : text(std::move(other.text))
+    {
+        constructions++;
+    }
+
+    TrackedKey & operator=(const TrackedKey &) = default;
+    TrackedKey & operator=(TrackedKey &&) noexcept = default;
+
+    // 与 std::string 一样可直接由 string_view 赋值，复用已有空间而不构造新 key
+    TrackedKey & operator=(std::string_view s)
+    {
+        text = s;
+        return *this;
+    }
+
+    friend bool operator==(const TrackedKey & a, const TrackedKey & b) { return a.text == b.text; }
+    friend bool operator==(const TrackedKey & a, std::string_view b) { return a.text == b; }
+};
+
+}
+
+template <>
+struct FreddyCache::FHash<TrackedKey>
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+
+    size_t operator()(const TrackedKey & key) const
+    {
+        return (*this)(std::string_view(key.text));
+    }
+};
+
+namespace
+{
+
+bool report(const std::string & name, bool passed)
+{
+    std::cout << name << ": " << (passed ? "通过" : "失败") << std::endl;
+    return passed;
+}
+
+const std::string_view KEYS[] = {
+    "heterogeneous-lookup-key-0000000000000000",
+    "heterogeneous-lookup-key-1111111111111111",
+    "heterogeneous-lookup-key-2222222222222222",
+};
+const std::string_view ABSENT = "heterogeneous-lookup-key-absent-000000000";
+
+// 写入后只用 string_view 读取、删除并确认删除生效；admitPuts 为新 key 进入主缓存所需的 put 次数。
+// 返回 string_view 路径上构造的 key 个数，结果不正确时返回 -1
+template <typename Key, typename Cache>
+long checkLookups(Cache & cache, int admitPuts)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int n = 0; n < admitPuts; ++n)
+            cache.put(Key(KEYS[i]), i);
+    }
+    // 另一个只写入一次的 key：LRU-K 下它停在待定区，删除也要把待定区清掉
+    cache.put(Key(ABSENT), 9);
+    cache.remove(Key(ABSENT));
+
+    size_t before = TrackedKey::constructions;
+    int value = -1;
+    bool correct = cache.get(KEYS[1], value) && value == 1;
+    correct = correct && !cache.get(ABSENT, value);
+    cache.remove(KEYS[1]);
+    correct = correct && !cache.get(KEYS[1], value);
+    correct = correct && cache.get(KEYS[2], value) && value == 2;
+    cache.remove(ABSENT);
+    long constructed = static_cast<long>(TrackedKey::constructions - before);
+    return correct ? constructed : -1;
+}
+
+// 同一策略分别以 std::string 与计数 key 实例化：前者检查结果，后者检查没有构造 key
+template <template <typename, typename> class Cache, typename... Args>
+bool checkPolicy(const std::string & name, int admitPuts, Args... args)
+{
+    Cache<std::string, int> plain(args...);
+    Cache<TrackedKey, int> tracked(args...);
+    long plainResult = checkLookups<std::string>(plain, admitPuts);
+    long constructed = checkLookups<TrackedKey>(tracked, admitPuts);
+    return report(name, plainResult >= 0 && constructed == 0);
+}
+
+}
+
+void testHeterogeneousLookup()
+{
+    std::cout << "\n=== 测试场景: string_view 查找与删除测试 ===" << std::endl;
+
+    const int CAPACITY = 8;
+    const int K = 2;
+    checkPolicy<FreddyCache::FLruCache>("LRU", 1, CAPACITY);
+    checkPolicy<FreddyCache::FLruKCache>("LRU-K", K, CAPACITY, CAPACITY, K);
+    checkPolicy<FreddyCache::FLfuCache>("LFU", 1, size_t(CAPACITY), size_t(100), size_t(10));
+    checkPolicy<FreddyCache::FSlruCache>("SLRU", 1, size_t(CAPACITY));
+    checkPolicy<FreddyCache::FGdsfCache>("GDSF", 1, size_t(CAPACITY));
+    checkPolicy<FreddyCache::FHashLruCache>("Hash-LRU", 1, size_t(CAPACITY), 4);
+
+    // 近端缓存在共享层命中时要把 key 存进线程本地表，只检查结果
+    FreddyCache::FHashLruCache<std::string, int> nearCache(CAPACITY, 4, 16);
+    report("Hash-LRU（近端缓存）", checkLookups<std::string>(nearCache, 1) >= 0);
+}
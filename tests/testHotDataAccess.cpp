@@ -1,10 +1,11 @@
 #include <iostream>
-#include <random>
 #include <vector>
 #include <string>
 
 #include "cachesTestBox.h"
+#include "report.h"
 #include "testUtils.h"
+#include "workload.h"
 
 void testHotDataAccess()
 {
@@ -23,59 +24,66 @@ void testHotDataAccess()
     auto & caches = ctb.caches;
     auto & hit_counts = ctb.hit_counts;
     auto & get_counts = ctb.get_counts;
+    auto & hit_costs = ctb.hit_costs;
+    auto & get_costs = ctb.get_costs;
     auto & cache_names = ctb.cache_names;
     auto & average_operation_time = ctb.average_operation_time;
+    auto & latency_samplers = ctb.latency_samplers;
 
-    // 初始化随机数种子
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // 预生成操作流：大多数缓存系统中读多于写，故设置30%写概率；70%概率访问热点数据
+    auto workload = generateWorkload({
+        { OPERATIONS, 0.30, std::make_shared<HotspotKeys>(HOT_KEYS, COLD_KEYS, 0.70) }
+    });
 
     // 测试缓存
     for (size_t i = 0; i < caches.size(); ++i)
     {
+        // 只有按代价淘汰的策略走 putWithCost，其余策略直接 put，不多绕一次虚调用
+        const bool costAware = ctb.cost_aware[i];
+
         // 预热
         for (int k = 0; k < HOT_KEYS; ++k)
         {
             std::string v = "value" + std::to_string(k);
-            caches[i]->put(k, v);
+            if (costAware)
+                caches[i]->putWithCost(k, v, missCost(k), 1);
+            else
+                caches[i]->put(k, v);
         }
 
         // 交替 put 与 get
-        for (int op = 0; op < OPERATIONS; ++op) {
-            // 大多数缓存系统中读多于写，故设置30%写概率
-            bool isPut = (gen() % 100 < 30);
-            // 设置70%概率访问热点数据
-            bool isHot = (gen() % 100 < 70);
-
-            // 生成 key
-            int k = isHot ? gen() % HOT_KEYS : HOT_KEYS + (gen() % COLD_KEYS);
-
-            // 生成操作
-            if (isPut)
+        std::string res;
+        latency_samplers[i].reserve(workload.ops.size());
+        Timer t;
+        for (const auto & op : workload.ops)
+        {
+            LatencySampler::Scope sample(latency_samplers[i]);
+            if (op.isPut)
             {
-                std::string v = "value" + std::to_string(k) + "_v" + std::to_string(op % 100);
-                Timer t;
-                caches[i] -> put(k, v);
-                double elapsed = t.elapsed();
-                average_operation_time[i] += elapsed;
+                if (costAware)
+                    caches[i]->putWithCost(op.key, workload.values[op.valueIndex], missCost(op.key), 1);
+                else
+                    caches[i]->put(op.key, workload.values[op.valueIndex]);
             }
             else
             {
-                std::string res;
                 get_counts[i]++;
-                Timer t;
-                bool isHit = caches[i]->get(k, res);
-                double elapsed = t.elapsed();
-                average_operation_time[i] += elapsed;
-                if (isHit)
+                double cost = missCost(op.key);
+                get_costs[i] += cost;
+                if (caches[i]->get(op.key, res))
+                {
                     hit_counts[i]++;
+                    hit_costs[i] += cost;
+                }
             }
-
         }
-
-        average_operation_time[i] /= OPERATIONS;
+        average_operation_time[i] = t.elapsed() / workload.ops.size();
     }
 
     // 输出结果
-    printResults("热点数据访问测试", CAPACITY, cache_names, get_counts, hit_counts, average_operation_time);
+    printResults("热点数据访问测试", CAPACITY, cache_names, get_counts, hit_counts, hit_costs, get_costs, average_operation_time);
+    recordResults("热点数据访问测试", {
+        { "capacity", CAPACITY }, { "k", K }, { "threshold", THRESHOLD }, { "granularity", GRANULARITY },
+        { "operations", OPERATIONS }, { "hot_keys", HOT_KEYS }, { "cold_keys", COLD_KEYS }
+    }, ctb, workload);
 }
\ No newline at end of file
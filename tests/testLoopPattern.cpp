@@ -1,10 +1,11 @@
 #include <iostream>
-#include <random>
 #include <vector>
 #include <string>
 
 #include "cachesTestBox.h"
+#include "report.h"
 #include "testUtils.h"
+#include "workload.h"
 
 void testLoopPattern()
 {
@@ -22,72 +23,70 @@ void testLoopPattern()
     auto & caches = ctb.caches;
     auto & hit_counts = ctb.hit_counts;
     auto & get_counts = ctb.get_counts;
+    auto & hit_costs = ctb.hit_costs;
+    auto & get_costs = ctb.get_costs;
     auto & cache_names = ctb.cache_names;
     auto & average_operation_time = ctb.average_operation_time;
+    auto & latency_samplers = ctb.latency_samplers;
 
-    // 初始化随机数种子
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // 预生成操作流：20%写概率；60% 顺序扫描，30% 随机跳跃，10% 外围访问
+    auto workload = generateWorkload({
+        { OPERATIONS, 0.20, std::make_shared<MixtureKeys>(std::vector<std::pair<double, KeyDistributionPtr>>{
+            { 0.60, std::make_shared<SequentialKeys>(0, LOOP_SIZE) },
+            { 0.30, std::make_shared<UniformKeys>(0, LOOP_SIZE) },
+            { 0.10, std::make_shared<UniformKeys>(LOOP_SIZE, LOOP_SIZE) }
+        }) }
+    });
 
     // 测试缓存
     for (size_t i = 0; i < caches.size(); ++i)
     {
+        // 只有按代价淘汰的策略走 putWithCost，其余策略直接 put，不多绕一次虚调用
+        const bool costAware = ctb.cost_aware[i];
+
         // 预热
         for (int k = 0; k < LOOP_SIZE / 5; ++k)
         {
             std::string v = "value" + std::to_string(k);
-            caches[i]->put(k, v);
+            if (costAware)
+                caches[i]->putWithCost(k, v, missCost(k), 1);
+            else
+                caches[i]->put(k, v);
         }
 
-        // 设置循环扫描当前位置
-        int current_pos = 0;
-
         // 交替 put 与 get
-        for (int op = 0; op < OPERATIONS; ++op) {
-            // 设置20%写概率
-            bool isPut = (gen() % 100 < 20);
-
-            // 生成 key
-            int k;
-            if (op % 100 < 60) // 60% 顺序扫描概率
-            {
-                k = current_pos;
-                current_pos = (current_pos + 1) % LOOP_SIZE;
-            }
-            else if (op % 100 < 90) // 30% 随机跳跃概率
-            {
-                k = gen() % LOOP_SIZE;
-            } else // 10% 外围访问概率
-            {
-                k = LOOP_SIZE + (gen() % LOOP_SIZE);
-            }
-
-            // 生成操作
-            if (isPut)
+        std::string res;
+        latency_samplers[i].reserve(workload.ops.size());
+        Timer t;
+        for (const auto & op : workload.ops)
+        {
+            LatencySampler::Scope sample(latency_samplers[i]);
+            if (op.isPut)
             {
-                std::string v = "loop" + std::to_string(k) + "_v" + std::to_string(op % 100);
-                Timer t;
-                caches[i] -> put(k, v);
-                double elapsed = t.elapsed();
-                average_operation_time[i] += elapsed;
+                if (costAware)
+                    caches[i]->putWithCost(op.key, workload.values[op.valueIndex], missCost(op.key), 1);
+                else
+                    caches[i]->put(op.key, workload.values[op.valueIndex]);
             }
             else
             {
-                std::string res;
                 get_counts[i]++;
-                Timer t;
-                bool isHit = caches[i]->get(k, res);
-                double elapsed = t.elapsed();
-                average_operation_time[i] += elapsed;
-                if (isHit)
+                double cost = missCost(op.key);
+                get_costs[i] += cost;
+                if (caches[i]->get(op.key, res))
+                {
                     hit_counts[i]++;
+                    hit_costs[i] += cost;
+                }
             }
-
         }
-
-        average_operation_time[i] /= OPERATIONS;
+        average_operation_time[i] = t.elapsed() / workload.ops.size();
     }
 
     // 输出结果
-    printResults("循环扫描测试", CAPACITY, cache_names, get_counts, hit_counts, average_operation_time);
+    printResults("循环扫描测试", CAPACITY, cache_names, get_counts, hit_counts, hit_costs, get_costs, average_operation_time);
+    recordResults("循环扫描测试", {
+        { "capacity", CAPACITY }, { "k", K }, { "threshold", THRESHOLD }, { "granularity", GRANULARITY },
+        { "operations", OPERATIONS }, { "loop_size", LOOP_SIZE }
+    }, ctb, workload);
 }
\ No newline at end of file
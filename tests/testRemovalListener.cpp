@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FLruCache.h"
+#include "FRemovalListener.h"
+#include "testUtils.h"
+
+namespace
+{
+
+using Notifier = FreddyCache::FRemovalNotifier<int, std::string>;
+using Event = Notifier::Event;
+using FreddyCache::FDeliveryMode;
+using FreddyCache::FRemovalCause;
+
+// 收集投递到的事件与批次大小，监听器可能在后台线程上执行
+struct Collector
+{
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::vector<size_t> batchSizes;
+
+    Notifier::Listener listener()
+    {
+        return [this](const std::vector<Event> & batch) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.insert(events.end(), batch.begin(), batch.end());
+            batchSizes.push_back(batch.size());
+        };
+    }
+
+    size_t delivered()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events.size();
+    }
+};
+
+bool report(const std::string & name, bool passed)
+{
+    std::cout << name << ": " << (passed ? "通过" : "失败") << std::endl;
+    return passed;
+}
+
+// 容量淘汰、同 key 覆盖与主动删除各自带上正确的原因与旧值
+bool checkCauses()
+{
+    Collector collector;
+    auto notifier = std::make_shared<Notifier>(collector.listener());
+    FreddyCache::FLruCache<int, std::string> cache(2);
+    cache.setRemovalNotifier(notifier);
+
+    cache.put(1, "a");
+    cache.put(2, "b");
+    cache.put(1, "c"); // 覆盖 1，旧值 a
+    cache.put(3, "d"); // 淘汰最久未访问的 2
+    cache.remove(1);   // 删除 1，值 c
+
+    const auto & e = collector.events;
+    return report("移除原因", e.size() == 3
+        && e[0].key == 1 && e[0].value == "a" && e[0].cause == FRemovalCause::Replaced
+        && e[1].key == 2 && e[1].value == "b" && e[1].cause == FRemovalCause::Size
+        && e[2].key == 1 && e[2].value == "c" && e[2].cause == FRemovalCause::Explicit);
+}
+
+// 后台模式：监听器卡住时写入线程停在队列满额处（背压），放行后按批送达，没有一批超过上限
+bool checkBackPressure()
+{
+    const size_t MAX_PENDING = 16; // 唤醒阈值为 8
+    const int BURST = 400;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool gateOpen = false;
+    std::vector<size_t> batchSizes;
+    size_t delivered = 0;
+    auto notifier = std::make_shared<Notifier>([&](const std::vector<Event> & batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        batchSizes.push_back(batch.size());
+        delivered += batch.size();
+        changed.notify_all();
+        changed.wait(lock, [&] { return gateOpen; });
+    }, MAX_PENDING, FDeliveryMode::Background);
+    FreddyCache::FLruCache<int, std::string> cache(1);
+    cache.setRemovalNotifier(notifier);
+
+    // 写入 k 淘汰 k - 1，写完 k 时累计入队 k 个事件
+    std::atomic<size_t> written{0};
+    std::thread writer([&] {
+        for (int k = 0; k <= BURST; ++k)
+        {
+            cache.put(k, "v");
+            written.store(k, std::memory_order_release);
+        }
+    });
+
+    size_t firstBatch;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return !batchSizes.empty(); });
+        firstBatch = batchSizes.front();
+    }
+    // 第一批卡在监听器里，队列涨到上限后写入线程在 dispatch 中等待，不会再前进
+    while (written.load(std::memory_order_acquire) < firstBatch + MAX_PENDING - 1)
+        std::this_thread::yield();
+    bool blocked = written.load(std::memory_order_acquire) == firstBatch + MAX_PENDING - 1;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        gateOpen = true;
+    }
+    changed.notify_all();
+    writer.join();
+    notifier->flush();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    bool bounded = *std::max_element(batchSizes.begin(), batchSizes.end()) <= MAX_PENDING;
+    bool batched = delivered == static_cast<size_t>(BURST) && batchSizes.size() < static_cast<size_t>(BURST);
+    std::cout << "\t" << BURST << " 次淘汰分 " << batchSizes.size() << " 批投递" << std::endl;
+    return report("队列上限与批量投递", blocked && bounded && batched);
+}
+
+// 内联模式下多个线程持续淘汰、监听器较慢：每个投递者只送一批就交出，
+// 单次写入不会被其他线程的写入拖住，队列深度受 maxPending 约束
+bool checkInlineWriters()
+{
+    const size_t MAX_PENDING = 16;
+    const int CAPACITY = 64;
+    const int WRITERS = 4;
+    const int PUTS = 5000;
+    const double MAX_PUT_US = 250000; // 每批约 200 μs，留足调度余量
+
+    std::mutex mutex;
+    size_t largestBatch = 0;
+    size_t delivered = 0;
+    auto notifier = std::make_shared<Notifier>([&](const std::vector<Event> & batch) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        std::lock_guard<std::mutex> lock(mutex);
+        largestBatch = std::max(largestBatch, batch.size());
+        delivered += batch.size();
+    }, MAX_PENDING, FDeliveryMode::Inline);
+    FreddyCache::FHashLruCache<int, std::string> cache(CAPACITY, 4);
+    cache.setRemovalNotifier(notifier);
+
+    std::vector<double> longestPut(WRITERS, 0);
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; ++w)
+    {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < PUTS; ++i)
+            {
+                Timer t;
+                cache.put(w * PUTS + i, "v");
+                longestPut[w] = std::max(longestPut[w], t.elapsed());
+            }
+        });
+    }
+    for (auto & writer : writers)
+        writer.join();
+    notifier->flush();
+
+    // 每个写入线程同一时刻至多有一次操作在入队，队列最多超出上限 WRITERS - 1 个事件
+    double longest = *std::max_element(longestPut.begin(), longestPut.end());
+    std::lock_guard<std::mutex> lock(mutex);
+    std::cout << "\t最长单次写入 " << longest / 1000 << " ms\t最大批次 " << largestBatch << std::endl;
+    return report("内联多线程写入", delivered + CAPACITY == static_cast<size_t>(WRITERS * PUTS)
+        && largestBatch < MAX_PENDING + WRITERS && longest < MAX_PUT_US);
+}
+
+// 后台模式保持淘汰顺序；通知器析构时送出剩余事件
+bool checkOrderingAndShutdown()
+{
+    const int KEYS = 1000;
+    Collector collector;
+    {
+        auto notifier = std::make_shared<Notifier>(collector.listener(), 64, FDeliveryMode::Background);
+        FreddyCache::FLruCache<int, std::string> cache(1);
+        cache.setRemovalNotifier(notifier);
+        for (int k = 0; k < KEYS; ++k)
+            cache.put(k, "v");
+    }
+
+    bool ordered = collector.events.size() == KEYS - 1;
+    for (size_t i = 0; ordered && i < collector.events.size(); ++i)
+        ordered = collector.events[i].key == static_cast<int>(i) && collector.events[i].cause == FRemovalCause::Size;
+    return report("后台投递顺序与析构送达", ordered);
+}
+
+// 监听器把被淘汰的 key 写回同一缓存：嵌套写入只入队，不死锁，事件全部送达
+bool checkReentrantPut(FDeliveryMode mode)
+{
+    const int KEYS = 200;
+    const int REINSERT_OFFSET = 10000;
+
+    FreddyCache::FLruCache<int, std::string> cache(4);
+    std::mutex mutex;
+    std::vector<int> evicted;
+    size_t reinserted = 0;
+    auto notifier = std::make_shared<Notifier>([&](const std::vector<Event> & batch) {
+        for (const auto & event : batch)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                evicted.push_back(event.key);
+            }
+            if (event.key < REINSERT_OFFSET)
+            {
+                cache.put(event.key + REINSERT_OFFSET, event.value);
+                std::lock_guard<std::mutex> lock(mutex);
+                reinserted++;
+            }
+        }
+    }, 2, mode);
+    cache.setRemovalNotifier(notifier);
+
+    for (int k = 0; k < KEYS; ++k)
+        cache.put(k, "v");
+    // 监听器内写回产生的事件留待下一批，反复 flush 直到不再有新事件
+    for (size_t seen = SIZE_MAX;;)
+    {
+        notifier->flush();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (evicted.size() == seen)
+            break;
+        seen = evicted.size();
+    }
+
+    // 每次写入新 key 都淘汰一个条目，最终缓存中留下 4 个
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string name = mode == FDeliveryMode::Inline ? "监听器内写回（内联）" : "监听器内写回（后台）";
+    return report(name, reinserted > 0 && evicted.size() + 4 == KEYS + reinserted);
+}
+
+}
+
+void testRemovalListener()
+{
+    std::cout << "\n=== 测试场景: 移除通知测试 ===" << std::endl;
+
+    checkCauses();
+    checkBackPressure();
+    checkInlineWriters();
+    checkOrderingAndShutdown();
+    checkReentrantPut(FDeliveryMode::Inline);
+    checkReentrantPut(FDeliveryMode::Background);
+}
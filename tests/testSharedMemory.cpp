@@ -0,0 +1,219 @@
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <vector>
+#include <string>
+#include <cstring>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "FShmLruCache.h"
+#include "FLruCache.h"
+#include "report.h"
+#include "testUtils.h"
+#include "workload.h"
+
+namespace
+{
+
+// 共享内存中的 value 需可平凡拷贝
+struct ShmValue
+{
+    char data[32];
+};
+
+struct WorkerResult
+{
+    int gets;
+    int hits;
+    double elapsed;
+};
+
+// 读穿透：未命中即回源写入缓存
+template <typename Cache, typename V>
+WorkerResult runWorker(Cache & cache, const Workload & workload, const V & value)
+{
+    WorkerResult result{0, 0, 0};
+    V res;
+    Timer t;
+    for (const auto & op : workload.ops)
+    {
+        if (op.isPut)
+        {
+            cache.put(op.key, value);
+            continue;
+        }
+
+        result.gets++;
+        if (cache.get(op.key, res))
+            result.hits++;
+        else
+            cache.put(op.key, value);
+    }
+    result.elapsed = t.elapsed();
+    return result;
+}
+
+}
+
+void testSharedMemory()
+{
+    std::cout << "\n=== 测试场景: 多进程共享缓存测试 ===" << std::endl;
+
+    const int CAPACITY = 1000;
+    const int SLICES = 8;
+    const int WORKERS = 4;
+    const int OPERATIONS = 100000;
+    const int KEYS = 5000;
+    const std::string SHM_NAME = "/fcache_test_" + std::to_string(getpid());
+
+    // 各进程负载：同一批热点，不同的种子
+    std::vector<Workload> workloads;
+    for (int w = 0; w < WORKERS; ++w)
+    {
+        workloads.push_back(generateWorkload({
+            { OPERATIONS, 0.05, std::make_shared<ScrambledZipfianKeys>(0, KEYS) }
+        }, DEFAULT_WORKLOAD_SEED + w));
+    }
+
+    ShmValue shmValue;
+    std::strncpy(shmValue.data, "shared_value", sizeof(shmValue.data));
+
+    // 子进程结果写入匿名共享映射
+    void * mapped = mmap(nullptr, sizeof(WorkerResult) * WORKERS, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED)
+    {
+        std::cout << "mmap 失败，跳过" << std::endl;
+        return;
+    }
+    auto * results = static_cast<WorkerResult *>(mapped);
+
+    FreddyCache::FShmLruCache<int, ShmValue>::unlink(SHM_NAME);
+    FreddyCache::FShmLruCache<int, ShmValue> cache(SHM_NAME, CAPACITY, SLICES);
+
+    // 确定性崩溃：子进程持有 key 0 所在分片的锁后通知父进程，父进程随即将其杀死；
+    // 下一个加锁者应拿到 EOWNERDEAD 并清空该分片，其余分片的数据保持不变
+    const int PRELOADED = 200;
+    for (int k = 0; k < PRELOADED; ++k)
+    {
+        cache.put(k, shmValue);
+    }
+    uint64_t recoveriesBefore = cache.recoveries();
+
+    int lockedPipe[2];
+    if (pipe(lockedPipe) != 0)
+    {
+        std::cout << "pipe 失败，跳过" << std::endl;
+        munmap(mapped, sizeof(WorkerResult) * WORKERS);
+        FreddyCache::FShmLruCache<int, ShmValue>::unlink(SHM_NAME);
+        return;
+    }
+    pid_t crasher = fork();
+    if (crasher == 0)
+    {
+        close(lockedPipe[0]);
+        FreddyCache::FShmLruCache<int, ShmValue> child(SHM_NAME, CAPACITY, SLICES);
+        auto lock = child.lockShardOf(0);
+        char byte = 1;
+        (void)!write(lockedPipe[1], &byte, 1);
+        for (;;)
+            pause();
+    }
+    close(lockedPipe[1]);
+    char byte;
+    bool locked = read(lockedPipe[0], &byte, 1) == 1;
+    close(lockedPipe[0]);
+    kill(crasher, SIGKILL);
+    waitpid(crasher, nullptr, 0);
+
+    ShmValue res;
+    bool shardReset = !cache.get(0, res);
+    uint64_t recovered = cache.recoveries() - recoveriesBefore;
+    size_t survivors = 0;
+    for (int k = 1; k < PRELOADED; ++k)
+    {
+        if (cache.get(k, res))
+            survivors++;
+    }
+    bool consistent = cache.verify() && cache.size() == survivors;
+    cache.put(0, shmValue);
+    bool usable = cache.get(0, res);
+    bool recoveryPassed = locked && shardReset && recovered == 1 && survivors > 0 && consistent && usable;
+    std::cout << "崩溃恢复校验: " << (recoveryPassed ? "通过" : "失败")
+              << "\t恢复分片数: " << recovered
+              << "\t其余分片保留条目: " << survivors << "/" << PRELOADED - 1
+              << "\t结构一致: " << (consistent ? "是" : "否") << std::endl;
+
+    std::vector<pid_t> pids;
+    for (int w = 0; w < WORKERS; ++w)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            FreddyCache::FShmLruCache<int, ShmValue> child(SHM_NAME, CAPACITY, SLICES);
+            results[w] = runWorker(child, workloads[w], shmValue);
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+    for (pid_t pid : pids)
+    {
+        waitpid(pid, nullptr, 0);
+    }
+
+    // 对照组：每个进程各持一份同容量的私有 Hash-LRU
+    std::vector<WorkerResult> privateResults;
+    for (int w = 0; w < WORKERS; ++w)
+    {
+        FreddyCache::FHashLruCache<int, std::string> privateCache(CAPACITY, SLICES);
+        privateResults.push_back(runWorker(privateCache, workloads[w], std::string("private_value")));
+    }
+
+    std::cout << "=== 多进程共享缓存测试 结果汇总 ===" << std::endl;
+    std::cout << "缓存大小: " << CAPACITY << "\t进程数: " << WORKERS << std::endl;
+    const ScenarioParameters parameters = {
+        { "capacity", CAPACITY }, { "slices", SLICES }, { "workers", WORKERS },
+        { "operations", OPERATIONS }, { "keys", KEYS }
+    };
+    auto report = [&](const std::string & name, const WorkerResult * r, int n) {
+        int gets = 0, hits = 0;
+        double elapsed = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            gets += r[i].gets;
+            hits += r[i].hits;
+            elapsed += r[i].elapsed;
+        }
+        std::cout   << name
+                    << "\t- 命中率: "
+                    << std::fixed << std::setprecision(2) << 100.0 * hits / gets << "% "
+                    << "(" << hits << "/" << gets << ")"
+                    << "\t- 平均操作时: "
+                    << std::fixed << std::setprecision(2) << elapsed / (n * OPERATIONS) << " μs"
+                    << std::endl;
+
+        // 跨进程计时无抽样时延与内存开销，仅登记命中率与吞吐
+        PolicyResult result{};
+        result.scenario = "多进程共享缓存测试";
+        result.policy = name;
+        result.parameters = parameters;
+        result.seed = DEFAULT_WORKLOAD_SEED;
+        result.operations = static_cast<size_t>(n) * OPERATIONS;
+        result.gets = gets;
+        result.hits = hits;
+        result.hitRate = gets > 0 ? static_cast<double>(hits) / gets : 0;
+        result.costWeightedHitRate = std::numeric_limits<double>::quiet_NaN(); // 未模拟回源代价，记为缺失
+        result.opsPerSecond = elapsed > 0 ? 1e6 * n * OPERATIONS / elapsed : 0;
+        recordResult(std::move(result));
+    };
+    report("共享", results, WORKERS);
+    report("私有", privateResults.data(), WORKERS); // 私有组合计占用 WORKERS 倍的缓存容量
+    std::cout << "共享段条目数: " << cache.size()
+              << "\t结构一致: " << (cache.verify() ? "是" : "否") << std::endl;
+
+    munmap(mapped, sizeof(WorkerResult) * WORKERS);
+    FreddyCache::FShmLruCache<int, ShmValue>::unlink(SHM_NAME);
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FSmallLruCache.h"
+#include "workload.h"
+
+namespace
+{
+
+bool report(const std::string & name, bool passed)
+{
+    std::cout << name << ": " << (passed ? "通过" : "失败") << std::endl;
+    return passed;
+}
+
+// 参照模型：按最近访问排序的数组，头部最新，满时淘汰尾部
+class ReferenceLru
+{
+private:
+    size_t capacity_;
+    std::vector<std::pair<int, int>> entries_;
+public:
+    explicit ReferenceLru(size_t capacity)
+        : capacity_(capacity)
+    {}
+
+    bool get(int key, int & value)
+    {
+        auto it = std::find_if(entries_.begin(), entries_.end(), [key](const auto & e) { return e.first == key; });
+        if (it == entries_.end())
+            return false;
+        value = it->second;
+        std::rotate(entries_.begin(), it, it + 1);
+        return true;
+    }
+
+    void put(int key, int value)
+    {
+        int old;
+        if (get(key, old))
+        {
+            entries_.front().second = value;
+            return;
+        }
+        if (entries_.size() == capacity_)
+            entries_.pop_back();
+        entries_.insert(entries_.begin(), { key, value });
+    }
+
+    void remove(int key)
+    {
+        std::erase_if(entries_, [key](const auto & e) { return e.first == key; });
+    }
+
+    size_t size() const
+    {
+        return entries_.size();
+    }
+};
+
+// 同一随机操作序列同时作用于参照模型、向量比较的 32 / 64 位 key 版本与逐个比较的 16 位 key 版本，
+// 每一步的命中、取值与条目数都必须一致；key 含负数与 0（未占用槽位的 key 也是 0）
+template <size_t Capacity>
+bool matchesReference()
+{
+    const int OPERATIONS = 20000;
+    const int KEY_RANGE = static_cast<int>(Capacity) * 2 + 3;
+
+    ReferenceLru reference(Capacity);
+    FreddyCache::FSmallLruCache<int32_t, int, Capacity> simd32;
+    FreddyCache::FSmallLruCache<int64_t, int, Capacity> simd64;
+    FreddyCache::FSmallLruCache<int16_t, int, Capacity> scalar;
+
+    WorkloadRng gen(DEFAULT_WORKLOAD_SEED + Capacity);
+    for (int n = 0; n < OPERATIONS; ++n)
+    {
+        int key = static_cast<int>(uniformBelow(gen, KEY_RANGE)) - KEY_RANGE / 2;
+        double u = uniformUnit(gen);
+        if (u < 0.4)
+        {
+            reference.put(key, n);
+            simd32.put(key, n);
+            simd64.put(key, n);
+            scalar.put(static_cast<int16_t>(key), n);
+        }
+        else if (u < 0.45)
+        {
+            reference.remove(key);
+            simd32.remove(key);
+            simd64.remove(key);
+            scalar.remove(static_cast<int16_t>(key));
+        }
+        else
+        {
+            int expected = -1, v32 = -1, v64 = -1, vScalar = -1;
+            bool hit = reference.get(key, expected);
+            if (simd32.get(key, v32) != hit || simd64.get(key, v64) != hit
+                || scalar.get(static_cast<int16_t>(key), vScalar) != hit)
+                return false;
+            if (hit && (v32 != expected || v64 != expected || vScalar != expected))
+                return false;
+        }
+
+        size_t size = reference.size();
+        if (simd32.size() != size || simd64.size() != size || scalar.size() != size)
+            return false;
+    }
+    return true;
+}
+
+// 填满后按打乱的顺序逐个访问，此后每插入一个新 key 都应恰好淘汰访问顺序中最早的旧 key；
+// 只用未命中的 get 检查淘汰对象，不改变访问顺序
+template <size_t Capacity>
+bool evictsInLruOrder()
+{
+    const int CAPACITY = static_cast<int>(Capacity);
+    FreddyCache::FSmallLruCache<int, int, Capacity> cache;
+    std::vector<int> order(Capacity);
+    for (int k = 0; k < CAPACITY; ++k)
+    {
+        cache.put(k, k);
+        order[k] = k;
+    }
+    WorkloadRng gen(DEFAULT_WORKLOAD_SEED);
+    for (int i = CAPACITY - 1; i > 0; --i)
+        std::swap(order[i], order[uniformBelow(gen, i + 1)]);
+
+    int value;
+    for (int k : order)
+        cache.get(k, value);
+
+    for (int n = 0; n < CAPACITY; ++n)
+    {
+        cache.put(CAPACITY + n, n);
+        if (cache.get(order[n], value) || cache.size() != Capacity)
+            return false;
+    }
+    for (int n = 0; n < CAPACITY; ++n)
+    {
+        if (!cache.get(CAPACITY + n, value) || value != n)
+            return false;
+    }
+    return true;
+}
+
+template <size_t Capacity>
+bool checkCapacity()
+{
+    return matchesReference<Capacity>() && evictsInLruOrder<Capacity>();
+}
+
+}
+
+void testSmallLruCache()
+{
+    std::cout << "\n=== 测试场景: 小容量 LRU 测试 ===" << std::endl;
+
+    report("容量 1", checkCapacity<1>());
+    report("容量 5", checkCapacity<5>());
+    report("容量 8", checkCapacity<8>());
+    report("容量 13", checkCapacity<13>());
+    report("容量 63", checkCapacity<63>());
+    report("容量 64", checkCapacity<64>());
+}
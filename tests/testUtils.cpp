@@ -1,14 +1,78 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 
 #include "testUtils.h"
 
+namespace
+{
+
+// 连续两次读时钟的最小间隔，即单次计时自带的偏差
+double clockOverhead()
+{
+    static const double overhead = [] {
+        double best = 1e9;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto a = std::chrono::steady_clock::now();
+            auto b = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(b - a).count());
+        }
+        return best;
+    }();
+    return overhead;
+}
+
+}
+
+void LatencySampler::add(double elapsed)
+{
+    samples_.push_back(std::max(0.0, elapsed - clockOverhead()));
+}
+
+double LatencySampler::mean() const
+{
+    if (samples_.empty())
+        return 0;
+
+    double sum = 0;
+    for (double s : samples_)
+        sum += s;
+    return sum / samples_.size();
+}
+
+double LatencySampler::stddev() const
+{
+    if (samples_.size() < 2)
+        return 0;
+
+    double m = mean();
+    double sum = 0;
+    for (double s : samples_)
+        sum += (s - m) * (s - m);
+    return std::sqrt(sum / (samples_.size() - 1));
+}
+
+double LatencySampler::percentile(double p) const
+{
+    if (samples_.empty())
+        return 0;
+
+    std::vector<double> sorted(samples_);
+    size_t rank = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
 void printResults(
     const std::string & testName,
     int capacity,
     const std::vector<std::string> & cache_names,
     const std::vector<int> & get_counts,
     const std::vector<int> & hit_counts,
+    const std::vector<double> & hit_costs,
+    const std::vector<double> & get_costs,
     const std::vector<double> & average_operation_time
 )
 {
@@ -22,6 +86,8 @@ void printResults(
                     << "\t- 命中率: "
                     << std::fixed << std::setprecision(2) << hitRate << "% "
                     << "(" << hit_counts[i] << "/" << get_counts[i] << ")"
+                    << "\t- 代价加权命中率: "
+                    << std::fixed << std::setprecision(2) << 100.0 * hit_costs[i] / get_costs[i] << "% "
                     << "\t- 平均操作时: "
                     << std::fixed << std::setprecision(2) << average_operation_time[i] << " μs"
                     << std::endl;
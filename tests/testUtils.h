@@ -1,3 +1,5 @@
+#pragma once
+
 #include <chrono>
 #include <string>
 #include <vector>
@@ -18,11 +20,58 @@ public:
     }
 };
 
+// 抽样计时：每 SAMPLE_EVERY 次操作单独计时一次，用于估计单次操作时延的分位数，
+// 其余操作不读时钟，整体耗时几乎不受影响
+class LatencySampler
+{
+public:
+    static const size_t SAMPLE_EVERY = 16;
+private:
+    std::vector<double> samples_; // μs，已扣除读时钟本身的开销
+    size_t counter_;
+public:
+    LatencySampler()
+        : counter_(0)
+    {}
+
+    // 在循环体开头声明，析构时记录本次操作耗时
+    class Scope
+    {
+    private:
+        LatencySampler * sampler_;
+        std::chrono::steady_clock::time_point start_;
+    public:
+        explicit Scope(LatencySampler & sampler)
+            : sampler_((sampler.counter_++ & (SAMPLE_EVERY - 1)) == 0 ? &sampler : nullptr)
+        {
+            if (sampler_)
+                start_ = std::chrono::steady_clock::now();
+        }
+
+        ~Scope()
+        {
+            if (sampler_)
+                sampler_->add(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count());
+        }
+    };
+
+    // 计时循环开始前按操作数预留抽样空间，避免扩容落在被测区间内
+    void reserve(size_t operations) { samples_.reserve(samples_.size() + operations / SAMPLE_EVERY + 1); }
+    void add(double elapsed);
+
+    size_t count() const { return samples_.size(); }
+    double mean() const;
+    double stddev() const;
+    double percentile(double p) const; // p 取 [0, 1]
+};
+
 void printResults(
     const std::string & testName,
     int capacity,
     const std::vector<std::string> & cache_names,
     const std::vector<int> & get_counts,
     const std::vector<int> & hit_counts,
+    const std::vector<double> & hit_costs,
+    const std::vector<double> & get_costs,
     const std::vector<double> & average_operate_time
 );
\ No newline at end of file
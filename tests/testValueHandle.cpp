@@ -0,0 +1,107 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FLruCache.h"
+#include "FLfuCache.h"
+
+namespace
+{
+
+bool report(const std::string & name, bool passed)
+{
+    std::cout << name << ": " << (passed ? "通过" : "失败") << std::endl;
+    return passed;
+}
+
+// 句柄指向的 value 地址与内容都不变
+template <typename Handle>
+bool unchanged(const Handle & handle, const std::string * address, const std::string & expected)
+{
+    return handle && &*handle == address && *handle == expected;
+}
+
+// 句柄在同 key 覆盖、容量淘汰与主动删除之后仍指向取出时的值；
+// 挂上移除通知器的策略还会把被移除的值交给监听器，钉住的值只能被拷贝而不能被移走
+template <typename Cache>
+bool checkHandles(Cache & cache, int capacity)
+{
+    using Notifier = FreddyCache::FRemovalNotifier<int, std::string>;
+    std::vector<Notifier::Event> events;
+    if constexpr (requires { cache.setRemovalNotifier(std::shared_ptr<Notifier>()); })
+    {
+        cache.setRemovalNotifier(std::make_shared<Notifier>([&](const std::vector<Notifier::Event> & batch) {
+            events.insert(events.end(), batch.begin(), batch.end());
+        }));
+    }
+
+    // 覆盖：旧句柄看到旧值，新的读取看到新值
+    cache.put(1, std::string(64, 'a'));
+    auto replaced = cache.getHandle(1);
+    const std::string * replacedAddress = &*replaced;
+    cache.put(1, std::string(64, 'b'));
+    std::string value;
+    bool replaceOk = unchanged(replaced, replacedAddress, std::string(64, 'a'))
+        && cache.get(1, value) && value == std::string(64, 'b');
+
+    // 淘汰：写入足够多的新 key 并反复读取，使其频次与新近程度都超过 1，把 1 挤出；
+    // 淘汰节点被回收复用时不能动到钉住的节点
+    auto evicted = cache.getHandle(1);
+    const std::string * evictedAddress = &*evicted;
+    for (int k = 100; k < 100 + 4 * capacity; ++k)
+    {
+        cache.put(k, std::string(64, 'x'));
+        for (int n = 0; n < 8; ++n)
+            cache.get(k, value);
+    }
+    bool evictOk = !cache.get(1, value) && unchanged(evicted, evictedAddress, std::string(64, 'b'));
+
+    // 删除：句柄的拷贝在原句柄释放后仍然有效
+    int last = 100 + 4 * capacity - 1;
+    auto removed = cache.getHandle(last);
+    auto copy = removed;
+    const std::string * removedAddress = &*removed;
+    cache.remove(last);
+    removed = {};
+    bool removeOk = !cache.get(last, value) && unchanged(copy, removedAddress, std::string(64, 'x'));
+
+    // 句柄全部释放后缓存照常工作
+    replaced = {};
+    evicted = {};
+    copy = {};
+    for (int k = 0; k < 2 * capacity; ++k)
+        cache.put(k, std::to_string(k));
+    bool reuseOk = cache.get(2 * capacity - 1, value) && value == std::to_string(2 * capacity - 1);
+
+    if constexpr (requires { cache.setRemovalNotifier(std::shared_ptr<Notifier>()); })
+        cache.setRemovalNotifier(nullptr);
+
+    bool eventsOk = true;
+    for (const auto & event : events)
+    {
+        if (event.key == 1 && event.cause == FreddyCache::FRemovalCause::Replaced)
+            eventsOk = eventsOk && event.value == std::string(64, 'a');
+        if (event.key == last && event.cause == FreddyCache::FRemovalCause::Explicit)
+            eventsOk = eventsOk && event.value == std::string(64, 'x');
+    }
+    return replaceOk && evictOk && removeOk && reuseOk && eventsOk;
+}
+
+}
+
+void testValueHandle()
+{
+    std::cout << "\n=== 测试场景: 值句柄测试 ===" << std::endl;
+
+    const int CAPACITY = 8;
+    FreddyCache::FLruCache<int, std::string> lru(CAPACITY);
+    FreddyCache::FLfuCache<int, std::string> lfu(CAPACITY, 100, 10);
+    FreddyCache::FSlruCache<int, std::string> slru(CAPACITY);
+    FreddyCache::FHashLruCache<int, std::string> hashLru(CAPACITY, 1);
+
+    report("LRU 句柄", checkHandles(lru, CAPACITY));
+    report("LFU 句柄", checkHandles(lfu, CAPACITY));
+    report("SLRU 句柄", checkHandles(slru, CAPACITY));
+    report("Hash-LRU 句柄", checkHandles(hashLru, CAPACITY));
+}
@@ -1,12 +1,15 @@
 #include <iostream>
-#include <random>
 #include <vector>
 #include <string>
 
 #include "cachesTestBox.h"
+#include "report.h"
 #include "testUtils.h"
+#include "timeline.h"
+#include "workload.h"
 
-void testWorkloadShift()
+// timelineCsvPath 非空时把逐窗口序列导出到该文件
+void testWorkloadShift(const std::string & timelineCsvPath)
 {
     std::cout << "\n=== 测试场景: 负载剧变测试 ===" << std::endl;
 
@@ -16,98 +19,104 @@ void testWorkloadShift()
     const int GRANULARITY = 10;
     const int OPERATIONS = 200000;
     const int PAHSE_LENGTH = OPERATIONS / 5;
+    const int WINDOW = 1000;
 
     // 装载缓存模型
     auto ctb = initCachesTestBox(CAPACITY, K, THRESHOLD, GRANULARITY);
     auto & caches = ctb.caches;
     auto & hit_counts = ctb.hit_counts;
     auto & get_counts = ctb.get_counts;
+    auto & hit_costs = ctb.hit_costs;
+    auto & get_costs = ctb.get_costs;
     auto & cache_names = ctb.cache_names;
     auto & average_operation_time = ctb.average_operation_time;
+    auto & latency_samplers = ctb.latency_samplers;
+    std::vector<HitRateTimeline> timelines(caches.size(), HitRateTimeline(WINDOW));
 
-    // 初始化随机数种子
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // 预生成五个阶段的操作流
+    auto workload = generateWorkload({
+        // 阶段1：热点访问，15%写概率, 热点范围 5
+        { PAHSE_LENGTH, 0.15, std::make_shared<UniformKeys>(0, 5) },
+        // 阶段2： 大范围随机，30%写概率，热点范围 400
+        { PAHSE_LENGTH, 0.30, std::make_shared<UniformKeys>(0, 400) },
+        // 阶段3： 顺序扫描，10%写概率，100 个键
+        { PAHSE_LENGTH, 0.10, std::make_shared<SequentialKeys>(0, 100) },
+        // 阶段4： 局部随机，25%写概率，产生 5 个局部区域，每个区域 15 个键
+        { PAHSE_LENGTH, 0.25, std::make_shared<LocalityKeys>(15, 5, 800) },
+        // 阶段5： 混合访问，20%写概率，概率决定热点范围
+        { PAHSE_LENGTH, 0.20, std::make_shared<MixtureKeys>(std::vector<std::pair<double, KeyDistributionPtr>>{
+            { 0.40, std::make_shared<UniformKeys>(0, 5) },
+            { 0.30, std::make_shared<UniformKeys>(5, 45) },
+            { 0.30, std::make_shared<UniformKeys>(50, 350) }
+        }) }
+    });
 
     // 测试缓存
     for (size_t i = 0; i < caches.size(); ++i)
     {
+        // 只有按代价淘汰的策略走 putWithCost，其余策略直接 put，不多绕一次虚调用
+        const bool costAware = ctb.cost_aware[i];
+
         // 预热
         for (int k = 0; k < 30; ++k)
         {
             std::string v = "init" + std::to_string(k);
-            caches[i]->put(k, v);
+            if (costAware)
+                caches[i]->putWithCost(k, v, missCost(k), 1);
+            else
+                caches[i]->put(k, v);
         }
 
-        // 交替 put 与 get
-        for (int op = 0; op < OPERATIONS; ++op) {
-            // 计算当前阶段
-            int phase = op / PAHSE_LENGTH;
-
-            // 设置各阶段写概率与 key 分布
-            int putProbability, k;
-            switch (phase)
-            {
-                case 0:
-                    putProbability = 15;
-                    k = gen() % 5;
-                    break; // 阶段1：热点访问，15%写概率, 热点范围 5
-                case 1:
-                    putProbability = 30;
-                    k = gen() % 400;
-                    break; // 阶段2： 大范围随机，30%写概率，热点范围 400
-                case 2:
-                    putProbability = 10;
-                    k = (op - phase * PAHSE_LENGTH) % 100;
-                    break; // 阶段3： 顺序扫描，10%写概率，100 个键
-                case 3:
-                {
-                    putProbability = 25;
-                    int locality = (op / 800) % 5;
-                    k = locality * 15 + (gen() % 15);
-                    break; // 阶段4： 局部随机，25%写概率，产生 5 个局部区域，每个区域 15 个键
-                }
-                case 4:
-                {
-                    putProbability = 20;
-                    int r = gen() % 100;
-                    if (r < 40)
-                        k = gen() % 5;
-                    else if (r < 70)
-                        k = 5 + (gen() % 45);
-                    else
-                        k = 50 + (gen() % 350);
-                    break; // 阶段5： 混合访问，20%写概率，概率决定热点范围
-                }
-            }
-            bool isPut = (gen() % 100 < putProbability);
+        // 交替 put 与 get，逐窗口记录
+        std::string res;
+        latency_samplers[i].reserve(workload.ops.size());
+        auto & timeline = timelines[i];
+        Timer t;
+        timeline.start(caches[i]->getEvictionCount(), workload.ops.size());
+        for (const auto & op : workload.ops)
+        {
+            if (timeline.windowDone(op.phase))
+                timeline.closeWindow(caches[i]->getEvictionCount());
 
-            // 生成操作
-            if (isPut)
+            LatencySampler::Scope sample(latency_samplers[i]);
+            if (op.isPut)
             {
-                std::string v = "value" + std::to_string(k) + "_p" + std::to_string(phase);
-                Timer t;
-                caches[i] -> put(k, v);
-                double elapsed = t.elapsed();
-                average_operation_time[i] += elapsed;
+                if (costAware)
+                    caches[i]->putWithCost(op.key, workload.values[op.valueIndex], missCost(op.key), 1);
+                else
+                    caches[i]->put(op.key, workload.values[op.valueIndex]);
+                timeline.recordPut(op.phase);
             }
             else
             {
-                std::string res;
                 get_counts[i]++;
-                Timer t;
-                bool isHit = caches[i]->get(k, res);
-                double elapsed = t.elapsed();
-                average_operation_time[i] += elapsed;
-                if (isHit)
+                double cost = missCost(op.key);
+                get_costs[i] += cost;
+                bool hit = caches[i]->get(op.key, res);
+                if (hit)
+                {
                     hit_counts[i]++;
+                    hit_costs[i] += cost;
+                }
+                timeline.recordGet(op.phase, hit);
             }
-
         }
-
-        average_operation_time[i] /= OPERATIONS;
+        timeline.closeWindow(caches[i]->getEvictionCount());
+        average_operation_time[i] = t.elapsed() / workload.ops.size();
     }
 
     // 输出结果
-    printResults("负载剧变测试", CAPACITY, cache_names, get_counts, hit_counts, average_operation_time);
+    printResults("负载剧变测试", CAPACITY, cache_names, get_counts, hit_counts, hit_costs, get_costs, average_operation_time);
+    recordResults("负载剧变测试", {
+        { "capacity", CAPACITY }, { "k", K }, { "threshold", THRESHOLD }, { "granularity", GRANULARITY },
+        { "operations", OPERATIONS }, { "phases", 5 }
+    }, ctb, workload);
+    printPhaseSummaries("负载剧变测试", cache_names, timelines);
+
+    if (timelineCsvPath.empty())
+        return;
+    if (writeTimelineCsv(timelineCsvPath, cache_names, timelines))
+        std::cout << "逐窗口序列已导出: " << timelineCsvPath << "（每窗口 " << WINDOW << " 次操作）" << std::endl;
+    else
+        std::cout << "写出逐窗口序列失败: " << timelineCsvPath << std::endl;
 }
\ No newline at end of file
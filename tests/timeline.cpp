@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+#include "timeline.h"
+
+HitRateTimeline::HitRateTimeline(size_t windowOps)
+    : windowOps_(windowOps > 0 ? windowOps : 1)
+    , nextOp_(0)
+    , windowEvictionBase_(0)
+    , windowStart_(std::chrono::steady_clock::now())
+    , current_{0, 0, 0, 0, 0, 0, 0}
+{}
+
+void HitRateTimeline::start(size_t evictions, size_t operations)
+{
+    gets_.reserve(operations);
+    windowEvictionBase_ = evictions;
+    windowStart_ = std::chrono::steady_clock::now();
+}
+
+void HitRateTimeline::closeWindow(size_t evictions)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (current_.ops > 0)
+    {
+        current_.evictions = evictions - windowEvictionBase_;
+        current_.elapsed = std::chrono::duration<double, std::micro>(now - windowStart_).count();
+        windows_.push_back(current_);
+    }
+
+    current_ = TimelineWindow{0, 0, 0, 0, 0, 0, 0};
+    windowEvictionBase_ = evictions;
+    windowStart_ = now;
+}
+
+// 阶段内首段连续 span 次读取命中率达到 target 时，返回其第一次读取距阶段起点的操作数
+static size_t findRecovery(const std::vector<GetSample> & gets, uint8_t phase, size_t phaseFirstOp, size_t phaseOps, double target)
+{
+    size_t first = 0;
+    while (first < gets.size() && gets[first].phase != phase)
+        first++;
+    size_t last = first;
+    while (last < gets.size() && gets[last].phase == phase)
+        last++;
+
+    // 读取不足一段时退化为整段统计
+    size_t span = std::min(RECOVERY_SPAN, last - first);
+    if (span == 0)
+        return phaseOps;
+
+    size_t hits = 0;
+    for (size_t i = first; i < first + span; ++i)
+        hits += gets[i].hit;
+    for (size_t begin = first; ; ++begin)
+    {
+        if (hits >= target * span)
+            return gets[begin].op - phaseFirstOp;
+        if (begin + span >= last)
+            return phaseOps;
+        hits += gets[begin + span].hit;
+        hits -= gets[begin].hit;
+    }
+}
+
+std::vector<PhaseSummary> summarizePhases(const HitRateTimeline & timeline, double recoveryFraction)
+{
+    const auto & windows = timeline.windows();
+    std::vector<PhaseSummary> summaries;
+    size_t begin = 0;
+    while (begin < windows.size())
+    {
+        // 连续的同阶段窗口构成一个阶段
+        size_t end = begin;
+        while (end < windows.size() && windows[end].phase == windows[begin].phase)
+            end++;
+
+        PhaseSummary summary{windows[begin].phase, 0, 0, 0, 0, 0, 0, 0};
+        double elapsed = 0;
+        size_t evictions = 0;
+        int steadyGets = 0, steadyHits = 0;
+        size_t steadyBegin = begin + (end - begin) / 2;
+        for (size_t i = begin; i < end; ++i)
+        {
+            summary.ops += windows[i].ops;
+            summary.gets += windows[i].gets;
+            summary.hits += windows[i].hits;
+            elapsed += windows[i].elapsed;
+            evictions += windows[i].evictions;
+            if (i >= steadyBegin)
+            {
+                steadyGets += windows[i].gets;
+                steadyHits += windows[i].hits;
+            }
+        }
+        summary.steadyHitRate = steadyGets > 0 ? static_cast<double>(steadyHits) / steadyGets : 0;
+        summary.averageLatency = elapsed / summary.ops;
+        summary.evictionRate = static_cast<double>(evictions) / summary.ops;
+
+        // 稳态为 0 时视为立即恢复；始终未达标时记为整个阶段长度
+        summary.recoveryOps = findRecovery(timeline.gets(), summary.phase, windows[begin].firstOp, summary.ops,
+            recoveryFraction * summary.steadyHitRate);
+        summaries.push_back(summary);
+        begin = end;
+    }
+    return summaries;
+}
+
+void printPhaseSummaries(
+    const std::string & testName,
+    const std::vector<std::string> & cache_names,
+    const std::vector<HitRateTimeline> & timelines
+)
+{
+    std::cout << "=== " << testName << " 分阶段结果 ===" << std::endl;
+    for (size_t i = 0; i < timelines.size(); ++i)
+    {
+        std::cout << cache_names[i] << std::endl;
+        for (const auto & s : summarizePhases(timelines[i]))
+        {
+            std::cout   << "  阶段" << s.phase + 1
+                        << "\t- 命中率: "
+                        << std::fixed << std::setprecision(2) << (s.gets > 0 ? 100.0 * s.hits / s.gets : 0) << "% "
+                        << "\t- 稳态命中率: "
+                        << std::fixed << std::setprecision(2) << 100.0 * s.steadyHitRate << "% "
+                        << "\t- 恢复用时: " << s.recoveryOps << " 次操作"
+                        << "\t- 淘汰率: "
+                        << std::fixed << std::setprecision(3) << s.evictionRate
+                        << "\t- 平均操作时: "
+                        << std::fixed << std::setprecision(2) << s.averageLatency << " μs"
+                        << std::endl;
+        }
+    }
+}
+
+bool writeTimelineCsv(
+    const std::string & path,
+    const std::vector<std::string> & cache_names,
+    const std::vector<HitRateTimeline> & timelines
+)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << "policy,window,first_op,phase,ops,gets,hits,hit_rate,evictions,eviction_rate,avg_latency_us\n";
+    for (size_t i = 0; i < timelines.size(); ++i)
+    {
+        const auto & windows = timelines[i].windows();
+        for (size_t w = 0; w < windows.size(); ++w)
+        {
+            const auto & win = windows[w];
+            out << cache_names[i] << ','
+                << w << ','
+                << win.firstOp << ','
+                << static_cast<int>(win.phase) << ','
+                << win.ops << ','
+                << win.gets << ','
+                << win.hits << ','
+                << (win.gets > 0 ? static_cast<double>(win.hits) / win.gets : 0) << ','
+                << win.evictions << ','
+                << static_cast<double>(win.evictions) / win.ops << ','
+                << win.elapsed / win.ops << '\n';
+        }
+    }
+    return static_cast<bool>(out);
+}
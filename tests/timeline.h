@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 按固定操作数分窗口记录命中率、淘汰率与时延，观察策略在负载切换后的恢复速度
+
+struct TimelineWindow
+{
+    size_t   firstOp;    // 窗口内第一条操作在负载中的下标
+    size_t   ops;
+    uint8_t  phase;
+    int      gets;
+    int      hits;
+    size_t   evictions;
+    double   elapsed;    // μs
+};
+
+// 单次读取的结果，用于在窗口之内定位恢复点
+struct GetSample
+{
+    uint32_t op;   // 在负载中的下标
+    uint8_t  phase;
+    bool     hit;
+};
+
+class HitRateTimeline
+{
+private:
+    size_t windowOps_;
+    size_t nextOp_;
+    size_t windowEvictionBase_;
+    std::chrono::steady_clock::time_point windowStart_;
+    TimelineWindow current_;
+    std::vector<TimelineWindow> windows_;
+    std::vector<GetSample> gets_;
+public:
+    explicit HitRateTimeline(size_t windowOps);
+
+    // 开始计时，evictions 为缓存当前的累计淘汰数；operations 为预计操作数，提前分配逐次读取记录
+    void start(size_t evictions, size_t operations = 0);
+
+    // 窗口写满或即将进入新阶段时为 true，此时应先 closeWindow 再 record
+    bool windowDone(uint8_t phase) const
+    {
+        return current_.ops > 0 && (current_.ops >= windowOps_ || phase != current_.phase);
+    }
+
+    void closeWindow(size_t evictions);
+
+    void recordGet(uint8_t phase, bool hit)
+    {
+        gets_.push_back(GetSample{static_cast<uint32_t>(nextOp_), phase, hit});
+        record(phase);
+        current_.gets++;
+        current_.hits += hit;
+    }
+
+    void recordPut(uint8_t phase)
+    {
+        record(phase);
+    }
+
+    const std::vector<TimelineWindow> & windows() const
+    {
+        return windows_;
+    }
+
+    const std::vector<GetSample> & gets() const
+    {
+        return gets_;
+    }
+
+private:
+    void record(uint8_t phase)
+    {
+        if (current_.ops++ == 0)
+        {
+            current_.firstOp = nextOp_;
+            current_.phase = phase;
+        }
+        nextOp_++;
+    }
+};
+
+// 单个阶段的汇总：稳态命中率取阶段后半段窗口；恢复所需操作数为阶段起点到首段
+// 连续 RECOVERY_SPAN 次读取命中率达到稳态 recoveryFraction 的起点之间的操作数，
+// 按逐次读取滑动计算，分辨率不受窗口大小限制
+struct PhaseSummary
+{
+    uint8_t phase;
+    size_t  ops;
+    int     gets;
+    int     hits;
+    double  steadyHitRate;
+    size_t  recoveryOps;
+    double  averageLatency;  // μs
+    double  evictionRate;    // 每次操作的淘汰数
+};
+
+const size_t RECOVERY_SPAN = 64;
+
+std::vector<PhaseSummary> summarizePhases(const HitRateTimeline & timeline, double recoveryFraction = 0.9);
+
+void printPhaseSummaries(
+    const std::string & testName,
+    const std::vector<std::string> & cache_names,
+    const std::vector<HitRateTimeline> & timelines
+);
+
+// 导出逐窗口序列供绘图，每行一个 (策略, 窗口)
+bool writeTimelineCsv(
+    const std::string & path,
+    const std::vector<std::string> & cache_names,
+    const std::vector<HitRateTimeline> & timelines
+);
@@ -0,0 +1,216 @@
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "workload.h"
+
+UniformKeys::UniformKeys(uint32_t start, uint32_t count)
+    : start_(start)
+    , count_(count)
+{}
+
+uint32_t UniformKeys::next(WorkloadRng & gen)
+{
+    return start_ + static_cast<uint32_t>(uniformBelow(gen, count_));
+}
+
+SequentialKeys::SequentialKeys(uint32_t start, uint32_t count)
+    : start_(start)
+    , count_(count)
+    , cursor_(0)
+{
+    if (count_ == 0)
+        throw std::invalid_argument("SequentialKeys count must be positive");
+}
+
+uint32_t SequentialKeys::next(WorkloadRng &)
+{
+    uint32_t key = start_ + cursor_;
+    cursor_ = (cursor_ + 1) % count_;
+    return key;
+}
+
+HotspotKeys::HotspotKeys(uint32_t hotKeys, uint32_t coldKeys, double hotOpFraction)
+    : hotKeys_(hotKeys)
+    , coldKeys_(coldKeys)
+    , hotOpFraction_(hotOpFraction)
+{}
+
+uint32_t HotspotKeys::next(WorkloadRng & gen)
+{
+    if (uniformUnit(gen) < hotOpFraction_)
+        return static_cast<uint32_t>(uniformBelow(gen, hotKeys_));
+    return hotKeys_ + static_cast<uint32_t>(uniformBelow(gen, coldKeys_));
+}
+
+ZipfianKeys::ZipfianKeys(uint32_t start, uint64_t items, double theta)
+    : start_(start)
+    , items_(items)
+    , theta_(theta)
+    , zetan_(0)
+{
+    // YCSB 的近似采样只对 0 < theta < 1 成立，theta == 1 时 alpha 发散
+    if (items_ == 0)
+        throw std::invalid_argument("ZipfianKeys items must be positive");
+    if (!(theta_ > 0 && theta_ < 1))
+        throw std::invalid_argument("ZipfianKeys theta must be within (0, 1)");
+
+    for (uint64_t i = 1; i <= items_; ++i)
+    {
+        zetan_ += 1.0 / std::pow(static_cast<double>(i), theta_);
+    }
+    double zeta2 = 1.0 + 1.0 / std::pow(2.0, theta_);
+    alpha_ = 1.0 / (1.0 - theta_);
+    eta_ = (1.0 - std::pow(2.0 / items_, 1.0 - theta_)) / (1.0 - zeta2 / zetan_);
+    halfPowTheta_ = 1.0 + std::pow(0.5, theta_);
+}
+
+uint32_t ZipfianKeys::next(WorkloadRng & gen)
+{
+    return start_ + static_cast<uint32_t>(nextRank(gen));
+}
+
+uint64_t ZipfianKeys::nextRank(WorkloadRng & gen)
+{
+    double u = uniformUnit(gen);
+    double uz = u * zetan_;
+    if (uz < 1.0)
+        return 0;
+    if (uz < halfPowTheta_)
+        return 1;
+    uint64_t rank = static_cast<uint64_t>(items_ * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+    return rank < items_ ? rank : items_ - 1;
+}
+
+ScrambledZipfianKeys::ScrambledZipfianKeys(uint32_t start, uint32_t count, double theta)
+    : start_(start)
+    , zipfian_(0, count, theta)
+    , permutation_(count)
+{
+    // rank 到 key 用 [0, count) 上的一个固定置换，不同 rank 不会落到同一个 key，热度分布保持不变
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        permutation_[i] = i;
+    }
+    WorkloadRng shuffle(count);
+    for (uint32_t i = count - 1; i > 0; --i)
+    {
+        std::swap(permutation_[i], permutation_[uniformBelow(shuffle, i + 1)]);
+    }
+}
+
+uint32_t ScrambledZipfianKeys::next(WorkloadRng & gen)
+{
+    return start_ + permutation_[zipfian_.nextRank(gen)];
+}
+
+LatestKeys::LatestKeys(uint32_t initialKeys, uint32_t window, uint32_t advanceEvery, double theta)
+    : latest_(initialKeys > 0 ? initialKeys - 1 : 0)
+    , advanceEvery_(advanceEvery)
+    , draws_(0)
+    , zipfian_(0, window, theta)
+{}
+
+uint32_t LatestKeys::next(WorkloadRng & gen)
+{
+    if (advanceEvery_ > 0 && ++draws_ >= advanceEvery_)
+    {
+        draws_ = 0;
+        ++latest_;
+    }
+    // 已插入的 key 少于窗口时，超出 latest_ 的 rank 重新抽取，等价于在 min(window, latest_ + 1) 个 key 上做 Zipfian，
+    // 不会把多出的概率都压到 key 0 上
+    uint64_t rank;
+    do
+    {
+        rank = zipfian_.nextRank(gen);
+    } while (rank > latest_);
+    return latest_ - static_cast<uint32_t>(rank);
+}
+
+LocalityKeys::LocalityKeys(uint32_t regionSize, uint32_t regionCount, uint32_t dwell)
+    : regionSize_(regionSize)
+    , regionCount_(regionCount)
+    , dwell_(dwell)
+    , draws_(0)
+{
+    if (regionSize_ == 0 || regionCount_ == 0 || dwell_ == 0)
+        throw std::invalid_argument("LocalityKeys regionSize, regionCount and dwell must be positive");
+}
+
+uint32_t LocalityKeys::next(WorkloadRng & gen)
+{
+    uint32_t region = static_cast<uint32_t>((draws_++ / dwell_) % regionCount_);
+    return region * regionSize_ + static_cast<uint32_t>(uniformBelow(gen, regionSize_));
+}
+
+MixtureKeys::MixtureKeys(const std::vector<std::pair<double, KeyDistributionPtr>> & components)
+{
+    double total = 0;
+    for (const auto & component : components)
+    {
+        total += component.first;
+        cumulativeWeights_.push_back(total);
+        distributions_.push_back(component.second);
+    }
+    for (auto & weight : cumulativeWeights_)
+    {
+        weight /= total;
+    }
+}
+
+uint32_t MixtureKeys::next(WorkloadRng & gen)
+{
+    double u = uniformUnit(gen);
+    size_t i = 0;
+    while (i + 1 < cumulativeWeights_.size() && u >= cumulativeWeights_[i])
+        ++i;
+    return distributions_[i]->next(gen);
+}
+
+Workload generateWorkload(
+    const std::vector<WorkloadPhase> & phases,
+    uint64_t seed,
+    size_t valuePoolSize
+)
+{
+    if (valuePoolSize == 0 || valuePoolSize > UINT16_MAX + 1)
+        throw std::invalid_argument("valuePoolSize out of range");
+    // WorkloadOp::phase 只有 8 位
+    if (phases.size() > UINT8_MAX + 1)
+        throw std::invalid_argument("too many workload phases");
+
+    Workload workload;
+    workload.seed = seed;
+
+    size_t totalOperations = 0;
+    for (const auto & phase : phases)
+    {
+        totalOperations += phase.operations;
+    }
+    workload.ops.reserve(totalOperations);
+
+    workload.values.reserve(valuePoolSize);
+    for (size_t i = 0; i < valuePoolSize; ++i)
+    {
+        workload.values.emplace_back("value_v" + std::to_string(i));
+    }
+
+    WorkloadRng gen(seed);
+    for (size_t p = 0; p < phases.size(); ++p)
+    {
+        const auto & phase = phases[p];
+        workload.phaseBoundaries.push_back(workload.ops.size());
+        for (size_t op = 0; op < phase.operations; ++op)
+        {
+            WorkloadOp w;
+            w.key = phase.keys->next(gen);
+            w.isPut = uniformUnit(gen) < phase.putRatio;
+            w.valueIndex = static_cast<uint16_t>(workload.ops.size() % valuePoolSize);
+            w.phase = static_cast<uint8_t>(p);
+            workload.ops.push_back(w);
+        }
+    }
+
+    return workload;
+}
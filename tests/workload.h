@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 负载生成器：在计时前一次性生成确定性的操作流，计时循环内只剩缓存调用
+
+using WorkloadRng = std::mt19937_64;
+
+// 均匀采样 [0, n)，乘法映射避免取模开销
+inline uint64_t uniformBelow(WorkloadRng & gen, uint64_t n)
+{
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(gen()) * n) >> 64);
+}
+
+// 均匀采样 [0, 1)
+inline double uniformUnit(WorkloadRng & gen)
+{
+    return (gen() >> 11) * 0x1.0p-53;
+}
+
+// key 分布接口
+class KeyDistribution
+{
+public:
+    virtual ~KeyDistribution() {};
+
+    virtual uint32_t next(WorkloadRng & gen) = 0;
+};
+
+using KeyDistributionPtr = std::shared_ptr<KeyDistribution>;
+
+// 均匀分布：[start, start + count)
+class UniformKeys : public KeyDistribution
+{
+private:
+    uint32_t start_;
+    uint32_t count_;
+public:
+    UniformKeys(uint32_t start, uint32_t count);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// 顺序扫描：start, start + 1, ..., start + count - 1 循环，count 须为正
+class SequentialKeys : public KeyDistribution
+{
+private:
+    uint32_t start_;
+    uint32_t count_;
+    uint32_t cursor_;
+public:
+    SequentialKeys(uint32_t start, uint32_t count);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// 热点分布：hotOpFraction 的访问落在 [0, hotKeys)，其余落在 [hotKeys, hotKeys + coldKeys)
+class HotspotKeys : public KeyDistribution
+{
+private:
+    uint32_t hotKeys_;
+    uint32_t coldKeys_;
+    double   hotOpFraction_;
+public:
+    HotspotKeys(uint32_t hotKeys, uint32_t coldKeys, double hotOpFraction);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// Zipfian 分布（YCSB 算法，构造时预计算 zeta，采样 O(1)），rank 0 最热
+class ZipfianKeys : public KeyDistribution
+{
+private:
+    uint32_t start_;
+    uint64_t items_;
+    double   theta_;
+    double   zetan_;
+    double   alpha_;
+    double   eta_;
+    double   halfPowTheta_;
+public:
+    ZipfianKeys(uint32_t start, uint64_t items, double theta = 0.99);
+
+    uint32_t next(WorkloadRng & gen) override;
+
+    // 仅返回 rank，供其他分布复用
+    uint64_t nextRank(WorkloadRng & gen);
+};
+
+// 打散的 Zipfian：热度服从 Zipfian，但热点 key 经固定置换散布到整个 key 空间
+class ScrambledZipfianKeys : public KeyDistribution
+{
+private:
+    uint32_t    start_;
+    ZipfianKeys zipfian_;
+    std::vector<uint32_t> permutation_;
+public:
+    ScrambledZipfianKeys(uint32_t start, uint32_t count, double theta = 0.99);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// Latest 分布：最新写入的 key 最热，每 advanceEvery 次采样插入一个新 key
+class LatestKeys : public KeyDistribution
+{
+private:
+    uint32_t    latest_;
+    uint32_t    advanceEvery_;
+    uint32_t    draws_;
+    ZipfianKeys zipfian_;
+public:
+    LatestKeys(uint32_t initialKeys, uint32_t window, uint32_t advanceEvery, double theta = 0.99);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// 局部性分布：每 dwell 次采样切换到下一个区域，区域内均匀访问
+class LocalityKeys : public KeyDistribution
+{
+private:
+    uint32_t regionSize_;
+    uint32_t regionCount_;
+    uint32_t dwell_;
+    uint64_t draws_;
+public:
+    LocalityKeys(uint32_t regionSize, uint32_t regionCount, uint32_t dwell);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// 混合分布：按权重选择子分布
+class MixtureKeys : public KeyDistribution
+{
+private:
+    std::vector<double> cumulativeWeights_;
+    std::vector<KeyDistributionPtr> distributions_;
+public:
+    MixtureKeys(const std::vector<std::pair<double, KeyDistributionPtr>> & components);
+
+    uint32_t next(WorkloadRng & gen) override;
+};
+
+// 未命中代价模型（毫秒）：按 key 哈希确定，约 10% 的 key 回源需 200ms，其余 1ms
+inline double missCost(uint32_t key)
+{
+    uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 32;
+    return (h % 10 == 0) ? 200.0 : 1.0;
+}
+
+// 单条操作，紧凑存放以减少计时循环内的缓存未命中
+struct WorkloadOp
+{
+    uint32_t key;
+    uint16_t valueIndex;
+    uint8_t  isPut;
+    uint8_t  phase;   // 阶段下标，generateWorkload 限制阶段数不超过 256
+};
+
+// 负载阶段：多个阶段顺序拼接即构成负载剧变
+struct WorkloadPhase
+{
+    size_t operations;
+    double putRatio;
+    KeyDistributionPtr keys;
+};
+
+struct Workload
+{
+    uint64_t seed;
+    std::vector<WorkloadOp> ops;
+    std::vector<std::string> values;
+    std::vector<size_t> phaseBoundaries; // 每个阶段的起始下标
+};
+
+const uint64_t DEFAULT_WORKLOAD_SEED = 20240917;
+
+Workload generateWorkload(
+    const std::vector<WorkloadPhase> & phases,
+    uint64_t seed = DEFAULT_WORKLOAD_SEED,
+    size_t valuePoolSize = 100
+);